@@ -16,4 +16,19 @@ class GLTFFORUE4_API UglTFForUE4Settings : public UObject
     GENERATED_UCLASS_BODY()
 
 public:
+    /// buffer options
+    UPROPERTY(EditAnywhere, Config, Category = "Buffer", meta = (ToolTip = "Load the buffers and images when they are accessed at first instead of loading all of them before importing"))
+    bool bLazyLoadBuffers;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Buffer", meta = (EditCondition = bLazyLoadBuffers, ClampMin = 0, ToolTip = "The least recently used buffers and images are released when the loaded size is over this budget (in MB), 0 means no limit"))
+    int32 LazyLoadBuffersBudgetInMB;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Buffer", meta = (ToolTip = "Read the external buffers and images in the background while importing"))
+    bool bPrefetchBuffers;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Buffer", meta = (ToolTip = "Keep the decoded draco compressed meshes in the saved directory, so importing the same data again doesn't decode it"))
+    bool bCacheDracoMeshes;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Buffer", meta = (EditCondition = bCacheDracoMeshes, ClampMin = 0, ToolTip = "The least recently used cached draco meshes are deleted when the cache is over this size (in MB), 0 means no limit"))
+    int32 DracoMeshesCacheSizeInMB;
 };
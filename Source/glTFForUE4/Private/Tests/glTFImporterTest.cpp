@@ -0,0 +1,1019 @@
+// Copyright(c) 2016 - 2021 Code 4 Game, Org. All Rights Reserved.
+
+#include "glTFForUE4PrivatePCH.h"
+#include "glTF/glTFImporter.h"
+
+#include <Misc/AutomationTest.h>
+#include <Misc/Base64.h>
+#include <HAL/IConsoleManager.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#if defined(ERROR)
+#define DRACO_MACRO_TEMP_ERROR      ERROR
+#undef ERROR
+#endif
+#include <draco/compression/encode.h>
+#include <draco/mesh/triangle_soup_mesh_builder.h>
+#if defined(DRACO_MACRO_TEMP_ERROR)
+#define ERROR           DRACO_MACRO_TEMP_ERROR
+#undef DRACO_MACRO_TEMP_ERROR
+#endif
+
+#define GLTF_AUTOMATION_TEST_FLAGS  (EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace glTFForUE4Test
+{
+    template<typename T>
+    void AppendBytes(TArray<uint8>& InOutBinary, const T& InValue)
+    {
+        const int32 Offset = InOutBinary.AddUninitialized(sizeof(T));
+        FMemory::Memcpy(InOutBinary.GetData() + Offset, &InValue, sizeof(T));
+    }
+
+    /// the buffer views of the vertex attributes start at the multiples of 4 bytes
+    int32 AlignBytes(TArray<uint8>& InOutBinary)
+    {
+        InOutBinary.AddZeroed(Align(InOutBinary.Num(), 4) - InOutBinary.Num());
+        return InOutBinary.Num();
+    }
+
+    /// a grid mesh with the positions and normals interleaved, the texcoords and indices packed, and one morph target
+    bool CreateGridMesh(int32 InColumnCount, int32 InRowCount, std::shared_ptr<libgltf::SGlTF>& OutGlTF, TArray<uint8>& OutBinary)
+    {
+        const int32 VertexCount = InColumnCount * InRowCount;
+        const int32 IndexCount = (InColumnCount - 1) * (InRowCount - 1) * 6;
+
+        OutBinary.Empty();
+        for (int32 y = 0; y < InRowCount; ++y)
+        {
+            for (int32 x = 0; x < InColumnCount; ++x)
+            {
+                AppendBytes(OutBinary, FVector(static_cast<float>(x), static_cast<float>(y), FMath::Sin(x * 0.1f) * FMath::Cos(y * 0.1f)));
+                AppendBytes(OutBinary, FVector(FMath::Sin(x * 0.3f), FMath::Cos(y * 0.3f), 1.0f).GetSafeNormal());
+            }
+        }
+        const int32 TexcoordsOffset = OutBinary.Num();
+        for (int32 y = 0; y < InRowCount; ++y)
+        {
+            for (int32 x = 0; x < InColumnCount; ++x)
+            {
+                AppendBytes(OutBinary, FVector2D(x / static_cast<float>(InColumnCount - 1), y / static_cast<float>(InRowCount - 1)));
+            }
+        }
+        const int32 IndicesOffset = OutBinary.Num();
+        for (int32 y = 0; y + 1 < InRowCount; ++y)
+        {
+            for (int32 x = 0; x + 1 < InColumnCount; ++x)
+            {
+                const uint32 Index = static_cast<uint32>(y * InColumnCount + x);
+                AppendBytes(OutBinary, Index);
+                AppendBytes(OutBinary, Index + 1);
+                AppendBytes(OutBinary, Index + InColumnCount);
+                AppendBytes(OutBinary, Index + 1);
+                AppendBytes(OutBinary, Index + InColumnCount + 1);
+                AppendBytes(OutBinary, Index + InColumnCount);
+            }
+        }
+
+        const FString Json = FString::Printf(TEXT("{")
+            TEXT("\"asset\":{\"version\":\"2.0\"},")
+            TEXT("\"buffers\":[{\"byteLength\":%d}],")
+            TEXT("\"bufferViews\":[")
+            TEXT("{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%d,\"byteStride\":24},")
+            TEXT("{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d},")
+            TEXT("{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d}],")
+            TEXT("\"accessors\":[")
+            TEXT("{\"bufferView\":0,\"byteOffset\":0,\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\"},")
+            TEXT("{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\"},")
+            TEXT("{\"bufferView\":1,\"byteOffset\":0,\"componentType\":5126,\"count\":%d,\"type\":\"VEC2\"},")
+            TEXT("{\"bufferView\":2,\"byteOffset\":0,\"componentType\":5125,\"count\":%d,\"type\":\"SCALAR\"}],")
+            TEXT("\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3,\"targets\":[{\"POSITION\":1}]}]}],")
+            TEXT("\"nodes\":[{\"mesh\":0}],")
+            TEXT("\"scenes\":[{\"nodes\":[0]}],")
+            TEXT("\"scene\":0}"),
+            OutBinary.Num(),
+            TexcoordsOffset, TexcoordsOffset, IndicesOffset - TexcoordsOffset, IndicesOffset, OutBinary.Num() - IndicesOffset,
+            VertexCount, VertexCount, VertexCount, IndexCount);
+
+        OutGlTF.reset();
+        const libgltf::string_t GlTFString = GLTF_TCHAR_TO_GLTFSTRING(*Json);
+        return (OutGlTF << GlTFString) && OutGlTF && !OutGlTF->meshes.empty();
+    }
+
+    /// the absolute transform by walking up to the root each time, like the level by level resolve did
+    FTransform GetAbsoluteTransformRecursively(int32 InNodeIndex, const TArray<int32>& InParentIndices, const TArray<FTransform>& InRelativeTransforms)
+    {
+        const int32 ParentIndex = InParentIndices[InNodeIndex];
+        if (ParentIndex == INDEX_NONE) return InRelativeTransforms[InNodeIndex];
+        return InRelativeTransforms[InNodeIndex] * GetAbsoluteTransformRecursively(ParentIndex, InParentIndices, InRelativeTransforms);
+    }
+
+    /// converts the same elements by the vector kernel and by the per-element conversion operators, the results must be equal
+    template<typename TEngineDataType>
+    bool ConvertAccessorElementsBothWays(const TArray<uint8>& InSource, int32 InStride, int32 InCount, int32 InComponentType, bool bSwapYZ, bool bInverseX, double& OutKernelTime, double& OutPerElementTime)
+    {
+        TArray<TEngineDataType> KernelDatas;
+        double StartTime = FPlatformTime::Seconds();
+        if (!FglTFImporter::ConvertAccessorElements(InSource.GetData(), InStride, InCount, InComponentType, false, bSwapYZ, bInverseX, false, KernelDatas)) return false;
+        OutKernelTime = FPlatformTime::Seconds() - StartTime;
+
+        TArray<TEngineDataType> PerElementDatas;
+        StartTime = FPlatformTime::Seconds();
+        if (!FglTFImporter::ConvertAccessorElements(InSource.GetData(), InStride, InCount, InComponentType, false, bSwapYZ, bInverseX, true, PerElementDatas)) return false;
+        OutPerElementTime = FPlatformTime::Seconds() - StartTime;
+
+        return KernelDatas.Num() == InCount && FMemory::Memcmp(KernelDatas.GetData(), PerElementDatas.GetData(), InCount * sizeof(TEngineDataType)) == 0;
+    }
+
+    struct FStaticMeshData
+    {
+        TArray<uint32> TriangleIndices;
+        TArray<FVector> VertexPositions;
+        TArray<TArray<FVector>> MorphTargetsVertexPositions;
+        TArray<FVector> VertexNormals;
+        TArray<TArray<FVector>> MorphTargetsVertexNormals;
+        TArray<FVector4> VertexTangents;
+        TArray<TArray<FVector4>> MorphTargetsVertexTangents;
+        TArray<FVector2D> VertexTexcoords[MAX_TEXCOORDS];
+
+        bool Get(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers)
+        {
+            return FglTFImporter::GetStaticMeshData(InGlTF, InGlTF->meshes[0]->primitives[0], InBuffers,
+                TriangleIndices, VertexPositions, MorphTargetsVertexPositions,
+                VertexNormals, MorphTargetsVertexNormals,
+                VertexTangents, MorphTargetsVertexTangents,
+                VertexTexcoords);
+        }
+
+        bool operator==(const FStaticMeshData& InOther) const
+        {
+            for (int32 i = 0; i < MAX_TEXCOORDS; ++i)
+            {
+                if (VertexTexcoords[i] != InOther.VertexTexcoords[i]) return false;
+            }
+            return TriangleIndices == InOther.TriangleIndices
+                && VertexPositions == InOther.VertexPositions
+                && MorphTargetsVertexPositions == InOther.MorphTargetsVertexPositions
+                && VertexNormals == InOther.VertexNormals
+                && MorphTargetsVertexNormals == InOther.MorphTargetsVertexNormals
+                && VertexTangents == InOther.VertexTangents
+                && MorphTargetsVertexTangents == InOther.MorphTargetsVertexTangents;
+        }
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterParallelDecodeTest, "glTFForUE4.Importer.ParallelDecode", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterParallelDecodeTest::RunTest(const FString& Parameters)
+{
+    using namespace glTFForUE4Test;
+
+    std::shared_ptr<libgltf::SGlTF> GlTF;
+    TArray<uint8> Binary;
+    if (!CreateGridMesh(128, 64, GlTF, Binary))
+    {
+        AddError(TEXT("Failed to create the grid mesh!"));
+        return false;
+    }
+    FglTFBuffers Buffers(true);
+    Buffers.CacheBinary(0, Binary);
+    Buffers.CacheAccessors(GlTF);
+
+    IConsoleVariable* ParallelDecodeVerticesMin = IConsoleManager::Get().FindConsoleVariable(TEXT("glTFForUE4.ParallelDecodeVerticesMin"));
+    if (!ParallelDecodeVerticesMin)
+    {
+        AddError(TEXT("Failed to find the console variable glTFForUE4.ParallelDecodeVerticesMin!"));
+        return false;
+    }
+    const int32 ParallelDecodeVerticesMinOld = ParallelDecodeVerticesMin->GetInt();
+
+    /// decode the same primitive in the calling thread and in the thread pool
+    FStaticMeshData SerialData;
+    ParallelDecodeVerticesMin->Set(MAX_int32, ECVF_SetByCode);
+    double StartTime = FPlatformTime::Seconds();
+    const bool bSerialDecoded = SerialData.Get(GlTF, Buffers);
+    const double SerialTime = FPlatformTime::Seconds() - StartTime;
+
+    FStaticMeshData ParallelData;
+    ParallelDecodeVerticesMin->Set(0, ECVF_SetByCode);
+    StartTime = FPlatformTime::Seconds();
+    const bool bParallelDecoded = ParallelData.Get(GlTF, Buffers);
+    const double ParallelTime = FPlatformTime::Seconds() - StartTime;
+
+    ParallelDecodeVerticesMin->Set(ParallelDecodeVerticesMinOld, ECVF_SetByCode);
+
+    TestTrue(TEXT("Decoded in the calling thread"), bSerialDecoded);
+    TestTrue(TEXT("Decoded in parallel"), bParallelDecoded);
+    TestEqual(TEXT("Vertex count"), SerialData.VertexPositions.Num(), 128 * 64);
+    TestEqual(TEXT("Morph target count"), SerialData.MorphTargetsVertexPositions.Num(), 1);
+    TestTrue(TEXT("The parallel decoded arrays are the same as the serial decoded ones"), SerialData == ParallelData);
+    UE_LOG(LogglTFForUE4, Display, TEXT("Decoded %d vertices in %.3f ms serially and %.3f ms in parallel"), SerialData.VertexPositions.Num(), SerialTime * 1000.0, ParallelTime * 1000.0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterBase64Test, "glTFForUE4.Importer.Base64", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterBase64Test::RunTest(const FString& Parameters)
+{
+    FRandomStream RandomStream(0x676c5446);
+    TArray<uint8> Source;
+
+    /// every length of the padded tails and of the simd blocks, and one large payload
+    TArray<int32> Lengths;
+    for (int32 i = 1; i <= 300; ++i) Lengths.Add(i);
+    Lengths.Add(16 * 1024 * 1024 + 1);
+
+    for (int32 Length : Lengths)
+    {
+        Source.SetNumUninitialized(Length);
+        for (int32 i = 0; i < Length; ++i)
+        {
+            Source[i] = static_cast<uint8>(RandomStream.RandHelper(256));
+        }
+        const FString Uri = FString(TEXT("data:application/octet-stream;base64,")) + FBase64::Encode(Source);
+
+        double StartTime = FPlatformTime::Seconds();
+        const FglTFBufferData BufferData(TEXT(""), Uri);
+        const double DecodeTime = FPlatformTime::Seconds() - StartTime;
+
+        const libgltf::string_t GlTFUri = GLTF_TCHAR_TO_GLTFSTRING(*Uri);
+        StartTime = FPlatformTime::Seconds();
+        const FglTFBufferData GlTFBufferData(TEXT(""), GlTFUri);
+        const double GlTFDecodeTime = FPlatformTime::Seconds() - StartTime;
+
+        if (BufferData.GetSize() != Length || FMemory::Memcmp(BufferData.GetData(), Source.GetData(), Length) != 0)
+        {
+            AddError(FString::Printf(TEXT("Failed to decode %d bytes from the data uri!"), Length));
+            return false;
+        }
+        if (GlTFBufferData.GetSize() != Length || FMemory::Memcmp(GlTFBufferData.GetData(), Source.GetData(), Length) != 0)
+        {
+            AddError(FString::Printf(TEXT("Failed to decode %d bytes from the glTF string!"), Length));
+            return false;
+        }
+
+        if (Length > 300)
+        {
+            TArray<uint8> EngineData;
+            StartTime = FPlatformTime::Seconds();
+            FBase64::Decode(Uri.RightChop(Uri.Find(TEXT(","), ESearchCase::CaseSensitive) + 1), EngineData);
+            const double EngineDecodeTime = FPlatformTime::Seconds() - StartTime;
+
+            TestTrue(TEXT("Decoded the same bytes as the engine"), EngineData == Source);
+            UE_LOG(LogglTFForUE4, Display, TEXT("Decoded %d bytes in %.3f ms from the data uri, %.3f ms from the glTF string and %.3f ms by the engine"), Length, DecodeTime * 1000.0, GlTFDecodeTime * 1000.0, EngineDecodeTime * 1000.0);
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterConvertAccessorsTest, "glTFForUE4.Importer.ConvertAccessors", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterConvertAccessorsTest::RunTest(const FString& Parameters)
+{
+    using namespace glTFForUE4Test;
+
+    const int32 VertexCount = 60000;
+    FRandomStream RandomStream(0x676c5446);
+
+    /// the float positions, the normalized int8 normals, int16 tangents, uint16 and uint8 texcoords, and uint16 indices
+    TArray<uint8> Binary;
+    const int32 PositionsOffset = AlignBytes(Binary);
+    for (int32 i = 0; i < VertexCount; ++i)
+    {
+        AppendBytes(Binary, RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, 100.0f));
+    }
+    const int32 NormalsOffset = AlignBytes(Binary);
+    for (int32 i = 0; i < VertexCount; ++i)
+    {
+        for (int32 j = 0; j < 3; ++j) AppendBytes(Binary, static_cast<int8>(RandomStream.RandRange(MIN_int8, MAX_int8)));
+        AppendBytes(Binary, static_cast<int8>(0));
+    }
+    const int32 TangentsOffset = AlignBytes(Binary);
+    for (int32 i = 0; i < VertexCount; ++i)
+    {
+        for (int32 j = 0; j < 4; ++j) AppendBytes(Binary, static_cast<int16>(RandomStream.RandRange(MIN_int16, MAX_int16)));
+    }
+    const int32 Texcoords0Offset = AlignBytes(Binary);
+    for (int32 i = 0; i < VertexCount; ++i)
+    {
+        for (int32 j = 0; j < 2; ++j) AppendBytes(Binary, static_cast<uint16>(RandomStream.RandRange(0, MAX_uint16)));
+    }
+    const int32 Texcoords1Offset = AlignBytes(Binary);
+    for (int32 i = 0; i < VertexCount; ++i)
+    {
+        for (int32 j = 0; j < 2; ++j) AppendBytes(Binary, static_cast<uint8>(RandomStream.RandRange(0, MAX_uint8)));
+        AppendBytes(Binary, static_cast<uint16>(0));
+    }
+    const int32 IndicesOffset = AlignBytes(Binary);
+    for (int32 i = 0; i < VertexCount; ++i)
+    {
+        AppendBytes(Binary, static_cast<uint16>(RandomStream.RandRange(0, VertexCount - 1)));
+    }
+    const int32 BinarySize = AlignBytes(Binary);
+
+    const FString Json = FString::Printf(TEXT("{")
+        TEXT("\"asset\":{\"version\":\"2.0\"},")
+        TEXT("\"extensionsUsed\":[\"KHR_mesh_quantization\"],")
+        TEXT("\"extensionsRequired\":[\"KHR_mesh_quantization\"],")
+        TEXT("\"buffers\":[{\"byteLength\":%d}],")
+        TEXT("\"bufferViews\":[")
+        TEXT("{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d},")
+        TEXT("{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d,\"byteStride\":4},")
+        TEXT("{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d},")
+        TEXT("{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d},")
+        TEXT("{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d,\"byteStride\":4},")
+        TEXT("{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d}],")
+        TEXT("\"accessors\":[")
+        TEXT("{\"bufferView\":0,\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\"},")
+        TEXT("{\"bufferView\":1,\"componentType\":5120,\"normalized\":true,\"count\":%d,\"type\":\"VEC3\"},")
+        TEXT("{\"bufferView\":2,\"componentType\":5122,\"normalized\":true,\"count\":%d,\"type\":\"VEC4\"},")
+        TEXT("{\"bufferView\":3,\"componentType\":5123,\"normalized\":true,\"count\":%d,\"type\":\"VEC2\"},")
+        TEXT("{\"bufferView\":4,\"componentType\":5121,\"normalized\":true,\"count\":%d,\"type\":\"VEC2\"},")
+        TEXT("{\"bufferView\":5,\"componentType\":5123,\"count\":%d,\"type\":\"SCALAR\"}],")
+        TEXT("\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TANGENT\":2,\"TEXCOORD_0\":3,\"TEXCOORD_1\":4},\"indices\":5}]}],")
+        TEXT("\"nodes\":[{\"mesh\":0}],")
+        TEXT("\"scenes\":[{\"nodes\":[0]}],")
+        TEXT("\"scene\":0}"),
+        BinarySize,
+        PositionsOffset, NormalsOffset - PositionsOffset,
+        NormalsOffset, TangentsOffset - NormalsOffset,
+        TangentsOffset, Texcoords0Offset - TangentsOffset,
+        Texcoords0Offset, Texcoords1Offset - Texcoords0Offset,
+        Texcoords1Offset, IndicesOffset - Texcoords1Offset,
+        IndicesOffset, BinarySize - IndicesOffset,
+        VertexCount, VertexCount, VertexCount, VertexCount, VertexCount, VertexCount);
+
+    std::shared_ptr<libgltf::SGlTF> GlTF;
+    const libgltf::string_t GlTFString = GLTF_TCHAR_TO_GLTFSTRING(*Json);
+    if (!(GlTF << GlTFString) || !GlTF || GlTF->meshes.empty())
+    {
+        AddError(TEXT("Failed to parse the quantized mesh!"));
+        return false;
+    }
+    FglTFBuffers Buffers(true);
+    Buffers.CacheBinary(0, Binary);
+    Buffers.CacheAccessors(GlTF);
+
+    for (int32 SwapYZ = 0; SwapYZ < 2; ++SwapYZ)
+    {
+        const bool bSwapYZ = (SwapYZ != 0);
+
+        /// the conversions of the glTF spec, done one component at a time
+        FStaticMeshData ExpectedData;
+        for (int32 i = 0; i < VertexCount; ++i)
+        {
+            FVector Position;
+            FMemory::Memcpy(&Position, Binary.GetData() + PositionsOffset + i * sizeof(FVector), sizeof(FVector));
+            ExpectedData.VertexPositions.Add(bSwapYZ ? FVector(Position.X, Position.Z, Position.Y) : FVector(-Position.X, Position.Y, Position.Z));
+
+            float Normal[3];
+            for (int32 j = 0; j < 3; ++j)
+            {
+                const int8 Component = *reinterpret_cast<const int8*>(Binary.GetData() + NormalsOffset + i * 4 + j);
+                Normal[j] = FMath::Max(static_cast<float>(Component) * (1.0f / 127.0f), -1.0f);
+            }
+            ExpectedData.VertexNormals.Add(bSwapYZ ? FVector(Normal[0], Normal[2], Normal[1]) : FVector(-Normal[0], Normal[1], Normal[2]));
+
+            float Tangent[4];
+            for (int32 j = 0; j < 4; ++j)
+            {
+                int16 Component;
+                FMemory::Memcpy(&Component, Binary.GetData() + TangentsOffset + (i * 4 + j) * sizeof(int16), sizeof(int16));
+                Tangent[j] = FMath::Max(static_cast<float>(Component) * (1.0f / 32767.0f), -1.0f);
+            }
+            ExpectedData.VertexTangents.Add(bSwapYZ ? FVector4(Tangent[0], Tangent[2], Tangent[1], Tangent[3]) : FVector4(-Tangent[0], Tangent[1], Tangent[2], Tangent[3]));
+
+            /// the texcoords are never swapped
+            uint16 Texcoord0[2];
+            FMemory::Memcpy(Texcoord0, Binary.GetData() + Texcoords0Offset + i * sizeof(Texcoord0), sizeof(Texcoord0));
+            ExpectedData.VertexTexcoords[0].Add(FVector2D(static_cast<float>(Texcoord0[0]) * (1.0f / 65535.0f), static_cast<float>(Texcoord0[1]) * (1.0f / 65535.0f)));
+
+            const uint8* Texcoord1 = Binary.GetData() + Texcoords1Offset + i * 4;
+            ExpectedData.VertexTexcoords[1].Add(FVector2D(static_cast<float>(Texcoord1[0]) * (1.0f / 255.0f), static_cast<float>(Texcoord1[1]) * (1.0f / 255.0f)));
+
+            uint16 Index;
+            FMemory::Memcpy(&Index, Binary.GetData() + IndicesOffset + i * sizeof(uint16), sizeof(uint16));
+            ExpectedData.TriangleIndices.Add(Index);
+        }
+
+        FStaticMeshData Data;
+        const double StartTime = FPlatformTime::Seconds();
+        const bool bDecoded = FglTFImporter::GetStaticMeshData(GlTF, GlTF->meshes[0]->primitives[0], Buffers,
+            Data.TriangleIndices, Data.VertexPositions, Data.MorphTargetsVertexPositions,
+            Data.VertexNormals, Data.MorphTargetsVertexNormals,
+            Data.VertexTangents, Data.MorphTargetsVertexTangents,
+            Data.VertexTexcoords, bSwapYZ);
+        const double DecodeTime = FPlatformTime::Seconds() - StartTime;
+
+        if (!bDecoded)
+        {
+            AddError(FString::Printf(TEXT("Failed to decode the quantized mesh, swap y and z: %d!"), SwapYZ));
+            return false;
+        }
+        TestTrue(TEXT("The indices are the same"), Data.TriangleIndices == ExpectedData.TriangleIndices);
+        TestEqual(TEXT("Vertex count"), Data.VertexPositions.Num(), VertexCount);
+        TestEqual(TEXT("Normal count"), Data.VertexNormals.Num(), VertexCount);
+        TestEqual(TEXT("Tangent count"), Data.VertexTangents.Num(), VertexCount);
+        TestEqual(TEXT("Texcoord 0 count"), Data.VertexTexcoords[0].Num(), VertexCount);
+        TestEqual(TEXT("Texcoord 1 count"), Data.VertexTexcoords[1].Num(), VertexCount);
+        if (HasAnyErrors()) return false;
+
+        const float Tolerance = 1.0e-6f;
+        for (int32 i = 0; i < VertexCount; ++i)
+        {
+            if (!Data.VertexPositions[i].Equals(ExpectedData.VertexPositions[i], Tolerance)
+                || !Data.VertexNormals[i].Equals(ExpectedData.VertexNormals[i], Tolerance)
+                || !Data.VertexTangents[i].Equals(ExpectedData.VertexTangents[i], Tolerance)
+                || !Data.VertexTexcoords[0][i].Equals(ExpectedData.VertexTexcoords[0][i], Tolerance)
+                || !Data.VertexTexcoords[1][i].Equals(ExpectedData.VertexTexcoords[1][i], Tolerance))
+            {
+                AddError(FString::Printf(TEXT("The vertex %d is converted wrongly, swap y and z: %d!"), i, SwapYZ));
+                return false;
+            }
+        }
+        UE_LOG(LogglTFForUE4, Display, TEXT("Converted %d quantized vertices in %.3f ms, swap y and z: %d"), VertexCount, DecodeTime * 1000.0, SwapYZ);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterDracoTest, "glTFForUE4.Importer.Draco", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterDracoTest::RunTest(const FString& Parameters)
+{
+    using namespace glTFForUE4Test;
+
+    std::shared_ptr<libgltf::SGlTF> GlTF;
+    TArray<uint8> Binary;
+    if (!CreateGridMesh(256, 256, GlTF, Binary))
+    {
+        AddError(TEXT("Failed to create the grid mesh!"));
+        return false;
+    }
+    const int32 VertexCount = 256 * 256;
+    const int32 IndexCount = 255 * 255 * 6;
+    const int32 FaceCount = IndexCount / 3;
+    const uint8* PositionsAndNormals = Binary.GetData();
+    const uint8* Texcoords = Binary.GetData() + GlTF->bufferViews[1]->byteOffset;
+    const uint8* Indices = Binary.GetData() + GlTF->bufferViews[2]->byteOffset;
+
+    /// the same triangles as a draco triangle soup, encoded losslessly and in the face order
+    draco::TriangleSoupMeshBuilder DracoMeshBuilder;
+    DracoMeshBuilder.Start(FaceCount);
+    const int32 PositionAttributeId = DracoMeshBuilder.AddAttribute(draco::GeometryAttribute::POSITION, 3, draco::DT_FLOAT32);
+    const int32 NormalAttributeId = DracoMeshBuilder.AddAttribute(draco::GeometryAttribute::NORMAL, 3, draco::DT_FLOAT32);
+    const int32 TexcoordAttributeId = DracoMeshBuilder.AddAttribute(draco::GeometryAttribute::TEX_COORD, 2, draco::DT_FLOAT32);
+    for (int32 i = 0; i < FaceCount; ++i)
+    {
+        uint32 Corners[3];
+        FMemory::Memcpy(Corners, Indices + i * sizeof(Corners), sizeof(Corners));
+        const draco::FaceIndex FaceIndex(static_cast<uint32>(i));
+        DracoMeshBuilder.SetAttributeValuesForFace(PositionAttributeId, FaceIndex, PositionsAndNormals + Corners[0] * 24, PositionsAndNormals + Corners[1] * 24, PositionsAndNormals + Corners[2] * 24);
+        DracoMeshBuilder.SetAttributeValuesForFace(NormalAttributeId, FaceIndex, PositionsAndNormals + Corners[0] * 24 + 12, PositionsAndNormals + Corners[1] * 24 + 12, PositionsAndNormals + Corners[2] * 24 + 12);
+        DracoMeshBuilder.SetAttributeValuesForFace(TexcoordAttributeId, FaceIndex, Texcoords + Corners[0] * 8, Texcoords + Corners[1] * 8, Texcoords + Corners[2] * 8);
+    }
+    std::unique_ptr<draco::Mesh> DracoMesh = DracoMeshBuilder.Finalize();
+    if (!DracoMesh)
+    {
+        AddError(TEXT("Failed to build the draco mesh!"));
+        return false;
+    }
+
+    draco::Encoder DracoEncoder;
+    DracoEncoder.SetEncodingMethod(draco::MESH_SEQUENTIAL_ENCODING);
+    draco::EncoderBuffer DracoEncoderBuffer;
+    if (!DracoEncoder.EncodeMeshToBuffer(*DracoMesh, &DracoEncoderBuffer).ok())
+    {
+        AddError(TEXT("Failed to encode the draco mesh!"));
+        return false;
+    }
+    TArray<uint8> DracoBinary;
+    DracoBinary.Append(reinterpret_cast<const uint8*>(DracoEncoderBuffer.data()), static_cast<int32>(DracoEncoderBuffer.size()));
+
+    const FString DracoJson = FString::Printf(TEXT("{")
+        TEXT("\"asset\":{\"version\":\"2.0\"},")
+        TEXT("\"extensionsUsed\":[\"KHR_draco_mesh_compression\"],")
+        TEXT("\"extensionsRequired\":[\"KHR_draco_mesh_compression\"],")
+        TEXT("\"buffers\":[{\"byteLength\":%d}],")
+        TEXT("\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%d}],")
+        TEXT("\"accessors\":[")
+        TEXT("{\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\"},")
+        TEXT("{\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\"},")
+        TEXT("{\"componentType\":5126,\"count\":%d,\"type\":\"VEC2\"},")
+        TEXT("{\"componentType\":5125,\"count\":%d,\"type\":\"SCALAR\"}],")
+        TEXT("\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3,")
+        TEXT("\"extensions\":{\"KHR_draco_mesh_compression\":{\"bufferView\":0,\"attributes\":{\"POSITION\":%d,\"NORMAL\":%d,\"TEXCOORD_0\":%d}}}}]}],")
+        TEXT("\"nodes\":[{\"mesh\":0}],")
+        TEXT("\"scenes\":[{\"nodes\":[0]}],")
+        TEXT("\"scene\":0}"),
+        DracoBinary.Num(), DracoBinary.Num(),
+        static_cast<int32>(DracoMesh->num_points()), static_cast<int32>(DracoMesh->num_points()), static_cast<int32>(DracoMesh->num_points()), IndexCount,
+        static_cast<int32>(DracoMesh->attribute(PositionAttributeId)->unique_id()),
+        static_cast<int32>(DracoMesh->attribute(NormalAttributeId)->unique_id()),
+        static_cast<int32>(DracoMesh->attribute(TexcoordAttributeId)->unique_id()));
+
+    std::shared_ptr<libgltf::SGlTF> DracoGlTF;
+    const libgltf::string_t DracoGlTFString = GLTF_TCHAR_TO_GLTFSTRING(*DracoJson);
+    if (!(DracoGlTF << DracoGlTFString) || !DracoGlTF || DracoGlTF->meshes.empty())
+    {
+        AddError(TEXT("Failed to parse the draco mesh!"));
+        return false;
+    }
+
+    FglTFBuffers Buffers(true);
+    Buffers.CacheBinary(0, Binary);
+    Buffers.CacheAccessors(GlTF);
+    FglTFBuffers DracoBuffers(true);
+    DracoBuffers.CacheBinary(0, DracoBinary);
+
+    FStaticMeshData Data;
+    double StartTime = FPlatformTime::Seconds();
+    const bool bDecoded = Data.Get(GlTF, Buffers);
+    const double DecodeTime = FPlatformTime::Seconds() - StartTime;
+
+    FStaticMeshData DracoData;
+    StartTime = FPlatformTime::Seconds();
+    const bool bDracoDecoded = DracoData.Get(DracoGlTF, DracoBuffers);
+    const double DracoDecodeTime = FPlatformTime::Seconds() - StartTime;
+
+    if (!bDecoded || !bDracoDecoded)
+    {
+        AddError(TEXT("Failed to decode the meshes!"));
+        return false;
+    }
+    TestEqual(TEXT("Vertex count"), Data.VertexPositions.Num(), VertexCount);
+    TestEqual(TEXT("Index count"), DracoData.TriangleIndices.Num(), Data.TriangleIndices.Num());
+    TestEqual(TEXT("Draco normal count"), DracoData.VertexNormals.Num(), DracoData.VertexPositions.Num());
+    TestEqual(TEXT("Draco texcoord count"), DracoData.VertexTexcoords[0].Num(), DracoData.VertexPositions.Num());
+    if (HasAnyErrors()) return false;
+
+    /// the points may be merged by the encoder, so each corner is compared by its values
+    for (int32 i = 0; i < Data.TriangleIndices.Num(); ++i)
+    {
+        const uint32 Index = Data.TriangleIndices[i];
+        const uint32 DracoIndex = DracoData.TriangleIndices[i];
+        if (DracoIndex >= static_cast<uint32>(DracoData.VertexPositions.Num())
+            || Data.VertexPositions[Index] != DracoData.VertexPositions[DracoIndex]
+            || Data.VertexNormals[Index] != DracoData.VertexNormals[DracoIndex]
+            || Data.VertexTexcoords[0][Index] != DracoData.VertexTexcoords[0][DracoIndex])
+        {
+            AddError(FString::Printf(TEXT("The corner %d of the draco mesh is different!"), i));
+            return false;
+        }
+    }
+    UE_LOG(LogglTFForUE4, Display, TEXT("Decoded %d faces in %.3f ms from the accessors and %.3f ms from the draco mesh with %d points"), FaceCount, DecodeTime * 1000.0, DracoDecodeTime * 1000.0, DracoData.VertexPositions.Num());
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterNodeTransformsTest, "glTFForUE4.Importer.NodeTransforms", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterNodeTransformsTest::RunTest(const FString& Parameters)
+{
+    using namespace glTFForUE4Test;
+
+    /// a chain of 256 nodes, and the others are the children of the random earlier nodes,
+    /// the node indices are shuffled so the children may be before their parents
+    const int32 NodeCount = 20000;
+    const int32 ChainLength = 256;
+    FRandomStream RandomStream(0x676c5446);
+
+    TArray<int32> NodeIndices;
+    for (int32 i = 0; i < NodeCount; ++i) NodeIndices.Add(i);
+    for (int32 i = NodeCount - 1; i > 0; --i) NodeIndices.Swap(i, RandomStream.RandRange(0, i));
+
+    TArray<int32> ExpectedParentIndices;
+    ExpectedParentIndices.Init(INDEX_NONE, NodeCount);
+    TArray<TArray<int32>> ChildIndices;
+    ChildIndices.SetNum(NodeCount);
+    for (int32 i = 1; i < NodeCount; ++i)
+    {
+        const int32 ParentIndex = NodeIndices[i < ChainLength ? (i - 1) : RandomStream.RandRange(0, i - 1)];
+        ExpectedParentIndices[NodeIndices[i]] = ParentIndex;
+        ChildIndices[ParentIndex].Add(NodeIndices[i]);
+    }
+
+    FString Nodes;
+    for (int32 i = 0; i < NodeCount; ++i)
+    {
+        const FQuat Rotation = FQuat(RandomStream.GetUnitVector(), RandomStream.FRandRange(-PI, PI));
+        const FVector Translation = RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, 10.0f);
+        const float Scale = RandomStream.FRandRange(0.99f, 1.01f);
+        if (i > 0) Nodes += TEXT(",");
+        Nodes += FString::Printf(TEXT("{\"translation\":[%f,%f,%f],\"rotation\":[%f,%f,%f,%f],\"scale\":[%f,%f,%f]"),
+            Translation.X, Translation.Y, Translation.Z, Rotation.X, Rotation.Y, Rotation.Z, Rotation.W, Scale, Scale, Scale);
+        if (ChildIndices[i].Num() > 0)
+        {
+            Nodes += TEXT(",\"children\":[");
+            for (int32 j = 0; j < ChildIndices[i].Num(); ++j)
+            {
+                Nodes += FString::Printf(j > 0 ? TEXT(",%d") : TEXT("%d"), ChildIndices[i][j]);
+            }
+            Nodes += TEXT("]");
+        }
+        Nodes += TEXT("}");
+    }
+    const FString Json = FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"nodes\":[%s],\"scenes\":[{\"nodes\":[%d]}],\"scene\":0}"), *Nodes, NodeIndices[0]);
+
+    std::shared_ptr<libgltf::SGlTF> GlTF;
+    const libgltf::string_t GlTFString = GLTF_TCHAR_TO_GLTFSTRING(*Json);
+    if (!(GlTF << GlTFString) || !GlTF || static_cast<int32>(GlTF->nodes.size()) != NodeCount)
+    {
+        AddError(TEXT("Failed to parse the nodes!"));
+        return false;
+    }
+
+    TArray<int32> ParentIndices;
+    TArray<FTransform> RelativeTransforms;
+    TArray<FTransform> AbsoluteTransforms;
+    double StartTime = FPlatformTime::Seconds();
+    const bool bResolved = FglTFImporter::GetNodeParentIndicesAndTransforms(GlTF, ParentIndices, RelativeTransforms, AbsoluteTransforms);
+    const double ResolveTime = FPlatformTime::Seconds() - StartTime;
+    if (!bResolved)
+    {
+        AddError(TEXT("Failed to resolve the node transforms!"));
+        return false;
+    }
+    TestTrue(TEXT("The parent indices are the same as the children"), ParentIndices == ExpectedParentIndices);
+    TestEqual(TEXT("Absolute transform count"), AbsoluteTransforms.Num(), NodeCount);
+    if (HasAnyErrors()) return false;
+
+    TArray<FTransform> ExpectedAbsoluteTransforms;
+    ExpectedAbsoluteTransforms.SetNum(NodeCount);
+    StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NodeCount; ++i)
+    {
+        ExpectedAbsoluteTransforms[i] = GetAbsoluteTransformRecursively(i, ParentIndices, RelativeTransforms);
+    }
+    const double RecursiveResolveTime = FPlatformTime::Seconds() - StartTime;
+
+    for (int32 i = 0; i < NodeCount; ++i)
+    {
+        if (!AbsoluteTransforms[i].Equals(ExpectedAbsoluteTransforms[i], KINDA_SMALL_NUMBER))
+        {
+            AddError(FString::Printf(TEXT("The absolute transform of the node %d is different!"), i));
+            return false;
+        }
+    }
+    UE_LOG(LogglTFForUE4, Display, TEXT("Resolved %d node transforms in %.3f ms in one pass and %.3f ms recursively"), NodeCount, ResolveTime * 1000.0, RecursiveResolveTime * 1000.0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterNodeTransformsScalingTest, "glTFForUE4.Importer.NodeTransformsScaling", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterNodeTransformsScalingTest::RunTest(const FString& Parameters)
+{
+    /// a pure wide hierarchy, one root and the others are its children, and a pure deep one, a chain of all nodes,
+    /// the node indices are shuffled, the time per node stays the same for the different sizes if it is linear
+    const int32 NodeCounts[] = { 16384, 65536 };
+    FRandomStream RandomStream(0x676c5446);
+
+    for (int32 Deep = 0; Deep < 2; ++Deep)
+    {
+        for (const int32 NodeCount : NodeCounts)
+        {
+            TArray<int32> NodeIndices;
+            for (int32 i = 0; i < NodeCount; ++i) NodeIndices.Add(i);
+            for (int32 i = NodeCount - 1; i > 0; --i) NodeIndices.Swap(i, RandomStream.RandRange(0, i));
+
+            TArray<int32> ExpectedParentIndices;
+            ExpectedParentIndices.Init(INDEX_NONE, NodeCount);
+            TArray<TArray<int32>> ChildIndices;
+            ChildIndices.SetNum(NodeCount);
+            for (int32 i = 1; i < NodeCount; ++i)
+            {
+                const int32 ParentIndex = NodeIndices[Deep ? (i - 1) : 0];
+                ExpectedParentIndices[NodeIndices[i]] = ParentIndex;
+                ChildIndices[ParentIndex].Add(NodeIndices[i]);
+            }
+
+            FString Nodes;
+            for (int32 i = 0; i < NodeCount; ++i)
+            {
+                const FQuat Rotation = FQuat(RandomStream.GetUnitVector(), RandomStream.FRandRange(-PI, PI));
+                const FVector Translation = RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, 10.0f);
+                if (i > 0) Nodes += TEXT(",");
+                Nodes += FString::Printf(TEXT("{\"translation\":[%f,%f,%f],\"rotation\":[%f,%f,%f,%f]"),
+                    Translation.X, Translation.Y, Translation.Z, Rotation.X, Rotation.Y, Rotation.Z, Rotation.W);
+                if (ChildIndices[i].Num() > 0)
+                {
+                    Nodes += TEXT(",\"children\":[");
+                    for (int32 j = 0; j < ChildIndices[i].Num(); ++j)
+                    {
+                        Nodes += FString::Printf(j > 0 ? TEXT(",%d") : TEXT("%d"), ChildIndices[i][j]);
+                    }
+                    Nodes += TEXT("]");
+                }
+                Nodes += TEXT("}");
+            }
+            const FString Json = FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"nodes\":[%s],\"scenes\":[{\"nodes\":[%d]}],\"scene\":0}"), *Nodes, NodeIndices[0]);
+
+            std::shared_ptr<libgltf::SGlTF> GlTF;
+            const libgltf::string_t GlTFString = GLTF_TCHAR_TO_GLTFSTRING(*Json);
+            if (!(GlTF << GlTFString) || !GlTF || static_cast<int32>(GlTF->nodes.size()) != NodeCount)
+            {
+                AddError(TEXT("Failed to parse the nodes!"));
+                return false;
+            }
+
+            TArray<int32> ParentIndices;
+            TArray<FTransform> RelativeTransforms;
+            TArray<FTransform> AbsoluteTransforms;
+            const double StartTime = FPlatformTime::Seconds();
+            const bool bResolved = FglTFImporter::GetNodeParentIndicesAndTransforms(GlTF, ParentIndices, RelativeTransforms, AbsoluteTransforms);
+            const double ResolveTime = FPlatformTime::Seconds() - StartTime;
+            if (!bResolved)
+            {
+                AddError(TEXT("Failed to resolve the node transforms!"));
+                return false;
+            }
+            TestTrue(TEXT("The parent indices are the same as the children"), ParentIndices == ExpectedParentIndices);
+            TestEqual(TEXT("Absolute transform count"), AbsoluteTransforms.Num(), NodeCount);
+            if (HasAnyErrors()) return false;
+
+            /// the parent's absolute transform is checked by itself, so one level is enough for each node
+            for (int32 i = 0; i < NodeCount; ++i)
+            {
+                const int32 ParentIndex = ParentIndices[i];
+                const FTransform ExpectedAbsoluteTransform = (ParentIndex == INDEX_NONE) ? RelativeTransforms[i] : RelativeTransforms[i] * AbsoluteTransforms[ParentIndex];
+                if (!AbsoluteTransforms[i].Equals(ExpectedAbsoluteTransform, KINDA_SMALL_NUMBER))
+                {
+                    AddError(FString::Printf(TEXT("The absolute transform of the node %d is different!"), i));
+                    return false;
+                }
+            }
+            UE_LOG(LogglTFForUE4, Display, TEXT("Resolved %d node transforms of a %s hierarchy in %.3f ms, %.1f ns per node"),
+                NodeCount, Deep ? TEXT("deep") : TEXT("wide"), ResolveTime * 1000.0, ResolveTime * 1e9 / NodeCount);
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterByteRangesTest, "glTFForUE4.Importer.ByteRanges", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterByteRangesTest::RunTest(const FString& Parameters)
+{
+    /// the byte offsets and lengths over 2 GB, like the BIN chunk of a big glb, only the json is parsed
+    const int64 Base = 2147483648ll;
+    const FString Json = FString::Printf(TEXT("{")
+        TEXT("\"asset\":{\"version\":\"2.0\"},")
+        TEXT("\"buffers\":[{\"byteLength\":%lld}],")
+        TEXT("\"bufferViews\":[")
+        TEXT("{\"buffer\":0,\"byteOffset\":16,\"byteLength\":%lld},")
+        TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":1024,\"byteStride\":16}],")
+        TEXT("\"accessors\":[")
+        TEXT("{\"bufferView\":0,\"byteOffset\":%lld,\"componentType\":5126,\"count\":10,\"type\":\"VEC3\"},")
+        TEXT("{\"bufferView\":1,\"byteOffset\":8,\"componentType\":5126,\"count\":8,\"type\":\"VEC2\"}]}"),
+        Base + 2048, Base + 1024, Base + 256, Base + 256);
+
+    std::shared_ptr<libgltf::SGlTF> GlTF;
+    const libgltf::string_t GlTFString = GLTF_TCHAR_TO_GLTFSTRING(*Json);
+    if (!(GlTF << GlTFString) || !GlTF || GlTF->accessors.size() != 2)
+    {
+        AddError(TEXT("Failed to parse the glTF with the byte ranges over 2 GB!"));
+        return false;
+    }
+    TestEqual(TEXT("Buffer byte length"), FglTFBuffers::ToByteSize(GlTF->buffers[0]->byteLength), Base + 2048);
+    TestEqual(TEXT("Buffer view byte length"), FglTFBuffers::ToByteSize(GlTF->bufferViews[0]->byteLength), Base + 1024);
+    TestEqual(TEXT("Buffer view byte offset"), FglTFBuffers::ToByteSize(GlTF->bufferViews[1]->byteOffset), Base + 256);
+    TestEqual(TEXT("Accessor byte offset"), FglTFBuffers::ToByteSize(GlTF->accessors[0]->byteOffset), Base + 256);
+
+    /// the loaded buffer is much shorter than declared, the views are checked against it
+    TArray<uint8> Binary;
+    Binary.AddZeroed(4096);
+    FglTFBuffers Buffers(true);
+    Buffers.CacheBinary(0, Binary);
+    Buffers.CacheAccessors(GlTF);
+
+    const FglTFAccessorDesc* PositionsDesc = Buffers.GetAccessorDesc(0);
+    const FglTFAccessorDesc* TexcoordsDesc = Buffers.GetAccessorDesc(1);
+    if (!PositionsDesc || !TexcoordsDesc)
+    {
+        AddError(TEXT("Failed to cache the accessors!"));
+        return false;
+    }
+    TestTrue(TEXT("The accessor in the buffer view over 2 GB is valid"), PositionsDesc->bValid);
+    TestEqual(TEXT("The offset of the accessor in the buffer view over 2 GB"), PositionsDesc->Offset, 16 + Base + 256);
+    TestTrue(TEXT("The accessor of the buffer view at 2 GB is valid"), TexcoordsDesc->bValid);
+    TestEqual(TEXT("The offset of the accessor of the buffer view at 2 GB"), TexcoordsDesc->Offset, Base + 256 + 8);
+    TestEqual(TEXT("The stride of the accessor of the buffer view at 2 GB"), TexcoordsDesc->Stride, 16);
+
+    TglTFAccessorView<FVector> PositionsView;
+    FString FilePath;
+    TestFalse(TEXT("The accessor past the loaded buffer is not viewed"), Buffers.GetAccessorView(*PositionsDesc, PositionsView, FilePath));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterGatherTest, "glTFForUE4.Importer.Gather", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterGatherTest::RunTest(const FString& Parameters)
+{
+    struct FLayout
+    {
+        int32 ElemSize;
+        int32 Stride;
+        const TCHAR* Name;
+    };
+    const FLayout Layouts[] = {
+        { 12, 24, TEXT("position in position+normal") },
+        { 12, 32, TEXT("position in position+normal+texcoord") },
+        { 8, 32, TEXT("texcoord in position+normal+texcoord") },
+        { 16, 48, TEXT("tangent in position+normal+tangent+texcoord") },
+        { 12, 44, TEXT("normal in position+normal+tangent+texcoord+color") },
+        { 4, 20, TEXT("color in position+texcoord+color") },
+        { 2, 8, TEXT("joint in joints+weights") },
+        { 6, 16, TEXT("unspecialized 6 bytes") },
+    };
+    const int32 ElementCount = 2 * 1024 * 1024;
+    FRandomStream RandomStream(0x676c5446);
+
+    for (const FLayout& Layout : Layouts)
+    {
+        /// the buffer ends right after the last element, so the kernels can't read past the last element's bytes
+        TArray<uint8> Source;
+        Source.SetNumUninitialized((ElementCount - 1) * Layout.Stride + Layout.ElemSize);
+        for (int32 i = 0; i < Source.Num(); ++i)
+        {
+            Source[i] = static_cast<uint8>(RandomStream.RandHelper(256));
+        }
+
+        TArray<uint8> Expected;
+        Expected.SetNumUninitialized(ElementCount * Layout.ElemSize);
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < ElementCount; ++i)
+        {
+            FMemory::Memcpy(Expected.GetData() + i * Layout.ElemSize, Source.GetData() + static_cast<int64>(i) * Layout.Stride, Layout.ElemSize);
+        }
+        const double MemcpyTime = FPlatformTime::Seconds() - StartTime;
+
+        TArray<uint8> Gathered;
+        Gathered.SetNumUninitialized(Expected.Num());
+        StartTime = FPlatformTime::Seconds();
+        FglTFBuffers::Gather(Gathered.GetData(), Source.GetData(), Layout.ElemSize, Layout.Stride, ElementCount);
+        const double GatherTime = FPlatformTime::Seconds() - StartTime;
+
+        if (Gathered != Expected)
+        {
+            AddError(FString::Printf(TEXT("Failed to gather the %s!"), Layout.Name));
+            return false;
+        }
+
+        /// the short views only run the tail
+        for (int32 Count = 1; Count <= 4; ++Count)
+        {
+            TArray<uint8> ShortGathered;
+            ShortGathered.SetNumUninitialized(Count * Layout.ElemSize);
+            FglTFBuffers::Gather(ShortGathered.GetData(), Source.GetData() + Source.Num() - ((Count - 1) * Layout.Stride + Layout.ElemSize), Layout.ElemSize, Layout.Stride, Count);
+            if (FMemory::Memcmp(ShortGathered.GetData(), Expected.GetData() + (ElementCount - Count) * Layout.ElemSize, ShortGathered.Num()) != 0)
+            {
+                AddError(FString::Printf(TEXT("Failed to gather the last %d elements of the %s!"), Count, Layout.Name));
+                return false;
+            }
+        }
+
+        UE_LOG(LogglTFForUE4, Display, TEXT("Gathered %d elements of %d bytes in %d bytes stride (%s): %.1f M/s by the kernel, %.1f M/s by the memcpy loop"),
+            ElementCount, Layout.ElemSize, Layout.Stride, Layout.Name,
+            ElementCount / FMath::Max(GatherTime, 1e-9) / 1e6, ElementCount / FMath::Max(MemcpyTime, 1e-9) / 1e6);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterSharedMeshDataTest, "glTFForUE4.Importer.SharedMeshData", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterSharedMeshDataTest::RunTest(const FString& Parameters)
+{
+    using namespace glTFForUE4Test;
+
+    std::shared_ptr<libgltf::SGlTF> GlTF;
+    TArray<uint8> Binary;
+    if (!CreateGridMesh(64, 64, GlTF, Binary))
+    {
+        AddError(TEXT("Failed to create the grid mesh!"));
+        return false;
+    }
+    /// two primitives read the same accessors
+    GlTF->meshes[0]->primitives.push_back(GlTF->meshes[0]->primitives[0]);
+
+    FglTFBuffers Buffers(true);
+    Buffers.CacheBinary(0, Binary);
+    Buffers.CacheAccessors(GlTF);
+    Buffers.CountAccessorReaders(GlTF, true, true, false, false);
+
+    FglTFMeshData MeshDatas[2];
+    for (int32 i = 0; i < 2; ++i)
+    {
+        if (!FglTFImporter::GetStaticMeshData(GlTF, GlTF->meshes[0]->primitives[i], Buffers, MeshDatas[i]))
+        {
+            AddError(FString::Printf(TEXT("Failed to decode the primitive %d!"), i));
+            return false;
+        }
+    }
+    TestTrue(TEXT("The positions are shared"), MeshDatas[0].VertexPositions.IsValid() && MeshDatas[0].VertexPositions == MeshDatas[1].VertexPositions);
+    TestTrue(TEXT("The normals are shared"), MeshDatas[0].VertexNormals.IsValid() && MeshDatas[0].VertexNormals == MeshDatas[1].VertexNormals);
+    TestTrue(TEXT("The texcoords are shared"), MeshDatas[0].VertexTexcoords[0].IsValid() && MeshDatas[0].VertexTexcoords[0] == MeshDatas[1].VertexTexcoords[0]);
+    TestTrue(TEXT("The indices are shared"), MeshDatas[0].TriangleIndices.IsValid() && MeshDatas[0].TriangleIndices == MeshDatas[1].TriangleIndices);
+    TestFalse(TEXT("The missing tangents are not decoded"), MeshDatas[0].VertexTangents.IsValid());
+
+    /// the shared positions are copied for the first owner, and moved to the last one
+    const FVector* SharedPositions = MeshDatas[0].VertexPositions->GetData();
+    TArray<FVector> OwnedPositions[2];
+    FglTFMeshData::MoveOrCopy(MeshDatas[0].VertexPositions, OwnedPositions[0]);
+    FglTFMeshData::MoveOrCopy(MeshDatas[1].VertexPositions, OwnedPositions[1]);
+    TestTrue(TEXT("The copied positions are the same as the moved ones"), OwnedPositions[0] == OwnedPositions[1]);
+    TestTrue(TEXT("The positions are copied for the first owner"), OwnedPositions[0].GetData() != SharedPositions);
+    TestTrue(TEXT("The positions are moved to the last owner"), OwnedPositions[1].GetData() == SharedPositions);
+    TestEqual(TEXT("Vertex count"), OwnedPositions[1].Num(), 64 * 64);
+
+    /// the legacy arrays are the same as the shared ones
+    FglTFBuffers LegacyBuffers(true);
+    LegacyBuffers.CacheBinary(0, Binary);
+    LegacyBuffers.CacheAccessors(GlTF);
+    FStaticMeshData LegacyData;
+    TestTrue(TEXT("Decoded to the legacy arrays"), LegacyData.Get(GlTF, LegacyBuffers));
+    TestTrue(TEXT("The legacy positions are the same"), LegacyData.VertexPositions == OwnedPositions[1]);
+    TestTrue(TEXT("The legacy normals are the same"), LegacyData.VertexNormals == FglTFMeshData::Get(MeshDatas[1].VertexNormals));
+    TestTrue(TEXT("The legacy indices are the same"), LegacyData.TriangleIndices == FglTFMeshData::Get(MeshDatas[1].TriangleIndices));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFImporterConvertAccessorsThroughputTest, "glTFForUE4.Importer.ConvertAccessorsThroughput", GLTF_AUTOMATION_TEST_FLAGS)
+
+bool FglTFImporterConvertAccessorsThroughputTest::RunTest(const FString& Parameters)
+{
+    using namespace glTFForUE4Test;
+
+    struct FComponent
+    {
+        int32 Type;
+        int32 Size;
+        const TCHAR* Name;
+    };
+    const FComponent Components[] = {
+        { 5120, 1, TEXT("int8") },
+        { 5121, 1, TEXT("uint8") },
+        { 5122, 2, TEXT("int16") },
+        { 5123, 2, TEXT("uint16") },
+        { 5125, 4, TEXT("uint32") },
+        { 5126, 4, TEXT("float") },
+    };
+    const TCHAR* const ElementNames[] = { TEXT("float"), TEXT("FVector2D"), TEXT("FVector"), TEXT("FVector4"), TEXT("FQuat") };
+    const int32 ElementComponentNums[] = { 1, 2, 3, 4, 4 };
+    const int32 VertexCount = 1024 * 1024;
+    FRandomStream RandomStream(0x676c5446);
+
+    for (const FComponent& Component : Components)
+    {
+        for (int32 ElementIndex = 0; ElementIndex < ARRAY_COUNT(ElementNames); ++ElementIndex)
+        {
+            /// the elements are aligned to 4 bytes like in a buffer view
+            const int32 Stride = Align(ElementComponentNums[ElementIndex] * Component.Size, 4);
+            TArray<uint8> Source;
+            Source.SetNumUninitialized(Stride * VertexCount);
+            for (int32 i = 0; i < Source.Num(); i += Component.Size)
+            {
+                if (Component.Type == 5126)
+                {
+                    const float Value = RandomStream.FRandRange(-100.0f, 100.0f);
+                    FMemory::Memcpy(Source.GetData() + i, &Value, sizeof(float));
+                }
+                else
+                {
+                    for (int32 j = 0; j < Component.Size; ++j)
+                    {
+                        Source[i + j] = static_cast<uint8>(RandomStream.RandHelper(256));
+                    }
+                }
+            }
+
+            for (int32 Flags = 0; Flags < 4; ++Flags)
+            {
+                const bool bSwapYZ = (Flags & 1) != 0;
+                const bool bInverseX = (Flags & 2) != 0;
+                double KernelTime = 0.0;
+                double PerElementTime = 0.0;
+                bool bEqual = false;
+                switch (ElementIndex)
+                {
+                case 0: bEqual = ConvertAccessorElementsBothWays<float>(Source, Stride, VertexCount, Component.Type, bSwapYZ, bInverseX, KernelTime, PerElementTime); break;
+                case 1: bEqual = ConvertAccessorElementsBothWays<FVector2D>(Source, Stride, VertexCount, Component.Type, bSwapYZ, bInverseX, KernelTime, PerElementTime); break;
+                case 2: bEqual = ConvertAccessorElementsBothWays<FVector>(Source, Stride, VertexCount, Component.Type, bSwapYZ, bInverseX, KernelTime, PerElementTime); break;
+                case 3: bEqual = ConvertAccessorElementsBothWays<FVector4>(Source, Stride, VertexCount, Component.Type, bSwapYZ, bInverseX, KernelTime, PerElementTime); break;
+                default: bEqual = ConvertAccessorElementsBothWays<FQuat>(Source, Stride, VertexCount, Component.Type, bSwapYZ, bInverseX, KernelTime, PerElementTime); break;
+                }
+                if (!bEqual)
+                {
+                    AddError(FString::Printf(TEXT("The kernel converted the %s to %s (swap %d, inverse %d) differently!"), Component.Name, ElementNames[ElementIndex], bSwapYZ ? 1 : 0, bInverseX ? 1 : 0));
+                    return false;
+                }
+
+                UE_LOG(LogglTFForUE4, Display, TEXT("Converted %d vertices of %s to %s (swap %d, inverse %d): %.1f M/s by the kernel, %.1f M/s by the conversion operators"),
+                    VertexCount, Component.Name, ElementNames[ElementIndex], bSwapYZ ? 1 : 0, bInverseX ? 1 : 0,
+                    VertexCount / FMath::Max(KernelTime, 1e-9) / 1e6, VertexCount / FMath::Max(PerElementTime, 1e-9) / 1e6);
+            }
+        }
+    }
+    return true;
+}
+
+#undef GLTF_AUTOMATION_TEST_FLAGS
+
+#endif
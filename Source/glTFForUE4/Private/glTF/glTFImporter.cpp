@@ -5,7 +5,6 @@
 
 #include "glTF/glTFImporterOptions.h"
 
-#include <Misc/Base64.h>
 #include <Misc/SecureHash.h>
 #include <Misc/FeedbackContext.h>
 #if ENGINE_MINOR_VERSION <= 13
@@ -14,12 +13,42 @@
 #include <Misc/FileHelper.h>
 #endif
 #include <Misc/Paths.h>
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+#include <Async/Async.h>
+#include <Async/ParallelFor.h>
+#include <HAL/PlatformFilemanager.h>
+#include <HAL/IConsoleManager.h>
+#include <GenericPlatform/GenericPlatformFile.h>
+
+#if defined(PLATFORM_ENABLE_VECTORINTRINSICS_NEON) && PLATFORM_ENABLE_VECTORINTRINSICS_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+#define GLTF_SIMD_NEON          1
+#include <arm_neon.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define GLTF_SIMD_SSE2          1
+#include <emmintrin.h>
+#endif
+#if !defined(GLTF_SIMD_NEON)
+#define GLTF_SIMD_NEON          0
+#endif
+#if !defined(GLTF_SIMD_SSE2)
+#define GLTF_SIMD_SSE2          0
+#endif
+
+/// the attributes of a smaller primitive are decoded in the calling thread
+static int32 GglTFParallelDecodeVerticesMin = 4096;
+static FAutoConsoleVariableRef CVarglTFParallelDecodeVerticesMin(
+    TEXT("glTFForUE4.ParallelDecodeVerticesMin"),
+    GglTFParallelDecodeVerticesMin,
+    TEXT("The attributes of a primitive with fewer vertices are decoded in the calling thread, 0 always decodes them in parallel"),
+    ECVF_Default);
 
 #include <Engine/StaticMesh.h>
 #include <Engine/SkeletalMesh.h>
 #include <Engine/StaticMeshActor.h>
 #include <Animation/SkeletalMeshActor.h>
 #include <Components/StaticMeshComponent.h>
+#include <Components/HierarchicalInstancedStaticMeshComponent.h>
 #include <Components/SkeletalMeshComponent.h>
 
 #if defined(ERROR)
@@ -99,28 +128,263 @@ FglTFImporterNodeInfo::FglTFImporterNodeInfo()
 
 const FglTFImporterNodeInfo FglTFImporterNodeInfo::Default;
 
+FglTFImporterSpawnRequest::FglTFImporterSpawnRequest()
+    : ParentRequestIndex(INDEX_NONE)
+    , Transform(FTransform::Identity)
+    , StaticMesh(nullptr)
+    , SkeletalMesh(nullptr)
+    , InstanceTransforms()
+{
+    //
+}
+
 FglTFImporterCollection::FglTFImporterCollection()
     : TargetWorld(nullptr)
-    , NodeInfos()
+    , NodeParentIndices()
+    , NodeRelativeTransforms()
+    , NodeAbsoluteTransforms()
     , Textures()
     , Materials()
     , StaticMeshes()
     , SkeletalMeshes()
+    , StaticMeshInstanceTransforms()
+    , SpawnRequests()
+    , NodeSpawnRequestIndices()
+    , NodesMerged()
+    , TexturesAdded()
+    , MaterialsAdded()
+    , StaticMeshesAdded()
+    , SkeletalMeshesAdded()
 {
     //
 }
 
-const FglTFImporterNodeInfo& FglTFImporterCollection::FindNodeInfo(int32 InNodeId) const
+void FglTFImporterCollection::Reserve(const std::shared_ptr<libgltf::SGlTF>& InGlTF)
+{
+    if (!InGlTF) return;
+
+    const int32 TextureCount = static_cast<int32>(InGlTF->textures.size());
+    const int32 MaterialCount = static_cast<int32>(InGlTF->materials.size());
+    const int32 MeshCount = static_cast<int32>(InGlTF->meshes.size());
+    const int32 NodeCount = static_cast<int32>(InGlTF->nodes.size());
+
+    Textures.SetNumZeroed(FMath::Max(Textures.Num(), TextureCount));
+    Materials.SetNumZeroed(FMath::Max(Materials.Num(), MaterialCount));
+    StaticMeshes.SetNumZeroed(FMath::Max(StaticMeshes.Num(), MeshCount));
+    SkeletalMeshes.SetNumZeroed(FMath::Max(SkeletalMeshes.Num(), MeshCount));
+    while (TexturesAdded.Num() < Textures.Num()) TexturesAdded.Add(false);
+    while (MaterialsAdded.Num() < Materials.Num()) MaterialsAdded.Add(false);
+    while (StaticMeshesAdded.Num() < StaticMeshes.Num()) StaticMeshesAdded.Add(false);
+    while (SkeletalMeshesAdded.Num() < SkeletalMeshes.Num()) SkeletalMeshesAdded.Add(false);
+
+    StaticMeshInstanceTransforms.SetNum(FMath::Max(StaticMeshInstanceTransforms.Num(), MeshCount));
+    NodeParentIndices.Reserve(NodeCount);
+    NodeRelativeTransforms.Reserve(NodeCount);
+    NodeAbsoluteTransforms.Reserve(NodeCount);
+    NodeSpawnRequestIndices.Reserve(NodeCount);
+    while (NodesMerged.Num() < NodeCount) NodesMerged.Add(false);
+}
+
+FglTFImporterNodeInfo FglTFImporterCollection::FindNodeInfo(int32 InNodeId) const
+{
+    if (!HasNodeInfo(InNodeId)) return FglTFImporterNodeInfo::Default;
+
+    FglTFImporterNodeInfo NodeInfo;
+    NodeInfo.ParentIndex = GetNodeParentIndex(InNodeId);
+    NodeInfo.RelativeTransform = GetNodeRelativeTransform(InNodeId);
+    NodeInfo.AbsoluteTransform = GetNodeAbsoluteTransform(InNodeId);
+    return NodeInfo;
+}
+
+namespace glTFImporter
 {
-    if (NodeInfos.Contains(InNodeId))
+    /// decode a base64 character, returns 0xFF if it is invalid
+    FORCEINLINE uint8 DecodeBase64Char(uint32 InChar)
+    {
+        if (InChar >= 'A' && InChar <= 'Z') return static_cast<uint8>(InChar - 'A');
+        if (InChar >= 'a' && InChar <= 'z') return static_cast<uint8>(InChar - 'a' + 26);
+        if (InChar >= '0' && InChar <= '9') return static_cast<uint8>(InChar - '0' + 52);
+        if (InChar == '+') return 62;
+        if (InChar == '/') return 63;
+        return 0xFF;
+    }
+
+    /// decode the blocks of 16 or 64 characters by simd, returns the count of decoded characters,
+    /// stops at the first block which has an invalid character and leaves it to the scalar loop
+    int64 DecodeBase64Blocks(const ANSICHAR* InSource, int64 InSourceLength, uint8* OutData)
+    {
+        int64 SourceIndex = 0;
+#if GLTF_SIMD_NEON
+        while (SourceIndex + 64 <= InSourceLength)
+        {
+            /// the characters 0, 1, 2 and 3 of each quad are in the separate registers
+            uint8x16x4_t Chars = vld4q_u8(reinterpret_cast<const uint8*>(InSource + SourceIndex));
+            uint8x16_t Valid = vdupq_n_u8(0xFF);
+            for (int32 i = 0; i < 4; ++i)
+            {
+                const uint8x16_t Char = Chars.val[i];
+                const uint8x16_t MaskUpper = vandq_u8(vcgeq_u8(Char, vdupq_n_u8('A')), vcleq_u8(Char, vdupq_n_u8('Z')));
+                const uint8x16_t MaskLower = vandq_u8(vcgeq_u8(Char, vdupq_n_u8('a')), vcleq_u8(Char, vdupq_n_u8('z')));
+                const uint8x16_t MaskDigit = vandq_u8(vcgeq_u8(Char, vdupq_n_u8('0')), vcleq_u8(Char, vdupq_n_u8('9')));
+                const uint8x16_t MaskPlus = vceqq_u8(Char, vdupq_n_u8('+'));
+                const uint8x16_t MaskSlash = vceqq_u8(Char, vdupq_n_u8('/'));
+                Valid = vandq_u8(Valid, vorrq_u8(vorrq_u8(vorrq_u8(MaskUpper, MaskLower), vorrq_u8(MaskDigit, MaskPlus)), MaskSlash));
+
+                uint8x16_t Offset = vandq_u8(MaskUpper, vdupq_n_u8(static_cast<uint8>(-'A')));
+                Offset = vorrq_u8(Offset, vandq_u8(MaskLower, vdupq_n_u8(static_cast<uint8>(26 - 'a'))));
+                Offset = vorrq_u8(Offset, vandq_u8(MaskDigit, vdupq_n_u8(static_cast<uint8>(52 - '0'))));
+                Offset = vorrq_u8(Offset, vandq_u8(MaskPlus, vdupq_n_u8(static_cast<uint8>(62 - '+'))));
+                Offset = vorrq_u8(Offset, vandq_u8(MaskSlash, vdupq_n_u8(static_cast<uint8>(63 - '/'))));
+                Chars.val[i] = vaddq_u8(Char, Offset);
+            }
+            if (vminvq_u8(Valid) != 0xFF) break;
+
+            uint8x16x3_t Bytes;
+            Bytes.val[0] = vorrq_u8(vshlq_n_u8(Chars.val[0], 2), vshrq_n_u8(Chars.val[1], 4));
+            Bytes.val[1] = vorrq_u8(vshlq_n_u8(Chars.val[1], 4), vshrq_n_u8(Chars.val[2], 2));
+            Bytes.val[2] = vorrq_u8(vshlq_n_u8(Chars.val[2], 6), Chars.val[3]);
+            vst3q_u8(OutData + SourceIndex / 4 * 3, Bytes);
+            SourceIndex += 64;
+        }
+#elif GLTF_SIMD_SSE2
+        while (SourceIndex + 16 <= InSourceLength)
+        {
+            const __m128i Char = _mm_loadu_si128(reinterpret_cast<const __m128i*>(InSource + SourceIndex));
+            /// the characters over 0x7F are negative and never in the ranges
+            const __m128i MaskUpper = _mm_and_si128(_mm_cmpgt_epi8(Char, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(Char, _mm_set1_epi8('Z' + 1)));
+            const __m128i MaskLower = _mm_and_si128(_mm_cmpgt_epi8(Char, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(Char, _mm_set1_epi8('z' + 1)));
+            const __m128i MaskDigit = _mm_and_si128(_mm_cmpgt_epi8(Char, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(Char, _mm_set1_epi8('9' + 1)));
+            const __m128i MaskPlus = _mm_cmpeq_epi8(Char, _mm_set1_epi8('+'));
+            const __m128i MaskSlash = _mm_cmpeq_epi8(Char, _mm_set1_epi8('/'));
+            const __m128i Valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(MaskUpper, MaskLower), _mm_or_si128(MaskDigit, MaskPlus)), MaskSlash);
+            if (_mm_movemask_epi8(Valid) != 0xFFFF) break;
+
+            __m128i Offset = _mm_and_si128(MaskUpper, _mm_set1_epi8(static_cast<char>(-'A')));
+            Offset = _mm_or_si128(Offset, _mm_and_si128(MaskLower, _mm_set1_epi8(static_cast<char>(26 - 'a'))));
+            Offset = _mm_or_si128(Offset, _mm_and_si128(MaskDigit, _mm_set1_epi8(static_cast<char>(52 - '0'))));
+            Offset = _mm_or_si128(Offset, _mm_and_si128(MaskPlus, _mm_set1_epi8(static_cast<char>(62 - '+'))));
+            Offset = _mm_or_si128(Offset, _mm_and_si128(MaskSlash, _mm_set1_epi8(static_cast<char>(63 - '/'))));
+            const __m128i Sextet = _mm_add_epi8(Char, Offset);
+
+            /// merge the sextets into 12 bits per 16 bits lane, and then into 24 bits per 32 bits lane
+            const __m128i Merged12 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(Sextet, _mm_set1_epi16(0x00FF)), 6), _mm_srli_epi16(Sextet, 8));
+            const __m128i Merged24 = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(Merged12, _mm_set1_epi32(0x0000FFFF)), 12), _mm_srli_epi32(Merged12, 16));
+
+            uint32 Lanes[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes), Merged24);
+            uint8* Data = OutData + SourceIndex / 4 * 3;
+            for (int32 i = 0; i < 4; ++i, Data += 3)
+            {
+                Data[0] = static_cast<uint8>(Lanes[i] >> 16);
+                Data[1] = static_cast<uint8>(Lanes[i] >> 8);
+                Data[2] = static_cast<uint8>(Lanes[i]);
+            }
+            SourceIndex += 16;
+        }
+#endif
+        return SourceIndex;
+    }
+
+    template<typename TChar>
+    int64 DecodeBase64Blocks(const TChar* InSource, int64 InSourceLength, uint8* OutData)
+    {
+        return 0;
+    }
+
+    /// decode the base64 characters into the data directly, without any intermediate string
+    template<typename TChar>
+    bool DecodeBase64(const TChar* InSource, int64 InSourceLength, TArray<uint8>& OutData)
+    {
+        if (!InSource || InSourceLength <= 0 || (InSourceLength % 4) != 0) return false;
+
+        int64 PaddingCount = 0;
+        if (InSource[InSourceLength - 1] == '=') ++PaddingCount;
+        if (InSource[InSourceLength - 2] == '=') ++PaddingCount;
+        const int64 DataLength = InSourceLength / 4 * 3 - PaddingCount;
+        if (DataLength > MAX_int32) return false;
+        OutData.SetNumUninitialized(static_cast<int32>(DataLength));
+        uint8* Data = OutData.GetData();
+
+        /// the last quad is handled by the scalar loop if it has the padding
+        const int64 FullSourceLength = PaddingCount > 0 ? (InSourceLength - 4) : InSourceLength;
+        int64 SourceIndex = DecodeBase64Blocks(InSource, FullSourceLength, Data);
+        for (; SourceIndex < InSourceLength; SourceIndex += 4)
+        {
+            const uint8 Sextet0 = DecodeBase64Char(InSource[SourceIndex + 0]);
+            const uint8 Sextet1 = DecodeBase64Char(InSource[SourceIndex + 1]);
+            const bool bLastQuad = (SourceIndex + 4 == InSourceLength);
+            const uint8 Sextet2 = (bLastQuad && PaddingCount >= 2) ? 0 : DecodeBase64Char(InSource[SourceIndex + 2]);
+            const uint8 Sextet3 = (bLastQuad && PaddingCount >= 1) ? 0 : DecodeBase64Char(InSource[SourceIndex + 3]);
+            if (Sextet0 == 0xFF || Sextet1 == 0xFF || Sextet2 == 0xFF || Sextet3 == 0xFF)
+            {
+                OutData.Empty();
+                return false;
+            }
+
+            const uint32 Merged = (Sextet0 << 18) | (Sextet1 << 12) | (Sextet2 << 6) | Sextet3;
+            const int64 DataIndex = SourceIndex / 4 * 3;
+            Data[DataIndex] = static_cast<uint8>(Merged >> 16);
+            if (DataIndex + 1 < DataLength) Data[DataIndex + 1] = static_cast<uint8>(Merged >> 8);
+            if (DataIndex + 2 < DataLength) Data[DataIndex + 2] = static_cast<uint8>(Merged);
+        }
+        return true;
+    }
+
+    /// parse the `data:[<type>][;<encoding>],<data>` and returns the start of the data, or INDEX_NONE if it is not a data uri
+    template<typename TChar>
+    int64 ParseDataUri(const TChar* InUri, int64 InUriLength, FString& OutStreamType, FString& OutStreamEncoding)
     {
-        return NodeInfos[InNodeId];
+        static const ANSICHAR UriStreamHead[] = "data:";
+        const int64 UriStreamHeadLength = ARRAY_COUNT(UriStreamHead) - 1;
+        if (InUriLength < UriStreamHeadLength) return INDEX_NONE;
+        for (int64 i = 0; i < UriStreamHeadLength; ++i)
+        {
+            if (FChar::ToLower(static_cast<TCHAR>(InUri[i])) != UriStreamHead[i]) return INDEX_NONE;
+        }
+
+        int64 StreamTypeEndIndex = INDEX_NONE;
+        int64 StreamEncodingEndIndex = INDEX_NONE;
+        for (int64 i = UriStreamHeadLength; i < InUriLength; ++i)
+        {
+            if (InUri[i] == ';' && StreamTypeEndIndex == INDEX_NONE)
+            {
+                StreamTypeEndIndex = i;
+            }
+            else if (InUri[i] == ',')
+            {
+                StreamEncodingEndIndex = i;
+                break;
+            }
+        }
+        if (StreamEncodingEndIndex == INDEX_NONE) return INDEX_NONE;
+        if (StreamTypeEndIndex == INDEX_NONE)
+        {
+            OutStreamType = FString(static_cast<int32>(StreamEncodingEndIndex - UriStreamHeadLength), InUri + UriStreamHeadLength);
+        }
+        else
+        {
+            OutStreamType = FString(static_cast<int32>(StreamTypeEndIndex - UriStreamHeadLength), InUri + UriStreamHeadLength);
+            OutStreamEncoding = FString(static_cast<int32>(StreamEncodingEndIndex - StreamTypeEndIndex - 1), InUri + StreamTypeEndIndex + 1);
+        }
+        return StreamEncodingEndIndex + 1;
     }
-    return FglTFImporterNodeInfo::Default;
 }
 
 FglTFBufferData::FglTFBufferData(const TArray<uint8>& InData)
     : Data(InData)
+    , ViewData(nullptr)
+    , ViewSize(0)
+    , ViewDataOwner()
+    , FilePath(TEXT(""))
+{
+    //
+}
+
+FglTFBufferData::FglTFBufferData(const uint8* InData, int64 InSize, const TSharedRef<FglTFBufferDataOwner, ESPMode::ThreadSafe>& InDataOwner)
+    : Data()
+    , ViewData(InData)
+    , ViewSize(InData ? InSize : 0)
+    , ViewDataOwner(InDataOwner)
     , FilePath(TEXT(""))
 {
     //
@@ -128,59 +392,116 @@ FglTFBufferData::FglTFBufferData(const TArray<uint8>& InData)
 
 FglTFBufferData::FglTFBufferData(const FString& InFileFolderRoot, const FString& InUri)
     : Data()
+    , ViewData(nullptr)
+    , ViewSize(0)
+    , ViewDataOwner()
     , FilePath(TEXT(""))
     , StreamType(TEXT(""))
     , StreamEncoding(TEXT(""))
 {
-    static const FString UriStreamHead(TEXT("data:"));
-    int32 StreamDataStartIndex = INDEX_NONE;
-    if (InUri.StartsWith(UriStreamHead, ESearchCase::IgnoreCase))
+    const int64 StreamDataStartIndex = glTFImporter::ParseDataUri(*InUri, InUri.Len(), StreamType, StreamEncoding);
+    if (StreamDataStartIndex != INDEX_NONE)
     {
-        int32 StreamTypeStartIndex = UriStreamHead.Len();
-        int32 StreamTypeEndIndex = InUri.Find(TEXT(";"), ESearchCase::IgnoreCase, ESearchDir::FromStart, StreamTypeStartIndex);
-        if (StreamTypeEndIndex != INDEX_NONE)
+        if (!glTFImporter::DecodeBase64(*InUri + StreamDataStartIndex, InUri.Len() - StreamDataStartIndex, Data))
         {
-            StreamType = InUri.Mid(StreamTypeStartIndex, StreamTypeEndIndex - StreamTypeStartIndex);
+            UE_LOG(LogglTFForUE4, Error, TEXT("Failed to decode the base64 data!"));
         }
-        int32 StreamEncodingStartIndex = StreamTypeEndIndex + 1;
-        int32 StreamEncodingEndIndex = InUri.Find(TEXT(","), ESearchCase::IgnoreCase, ESearchDir::FromStart, StreamEncodingStartIndex);
-        if (StreamEncodingEndIndex != INDEX_NONE)
+    }
+    else
+    {
+        if (LoadFile(InFileFolderRoot / InUri))
         {
-            StreamEncoding = InUri.Mid(StreamEncodingStartIndex, StreamEncodingEndIndex - StreamEncodingStartIndex);
-
-            StreamDataStartIndex = StreamEncodingEndIndex + 1;
+            FilePath = InFileFolderRoot / InUri;
         }
     }
+}
 
+FglTFBufferData::FglTFBufferData(const FString& InFileFolderRoot, const libgltf::string_t& InUri)
+    : Data()
+    , ViewData(nullptr)
+    , ViewSize(0)
+    , ViewDataOwner()
+    , FilePath(TEXT(""))
+    , StreamType(TEXT(""))
+    , StreamEncoding(TEXT(""))
+{
+    /// decode the data uri from the parsed string directly, it may be hundreds of MB
+    const int64 UriLength = static_cast<int64>(InUri.size());
+    const int64 StreamDataStartIndex = glTFImporter::ParseDataUri(InUri.c_str(), UriLength, StreamType, StreamEncoding);
     if (StreamDataStartIndex != INDEX_NONE)
     {
-        if (!FBase64::Decode(InUri.RightChop(StreamDataStartIndex), Data))
+        if (!glTFImporter::DecodeBase64(InUri.c_str() + StreamDataStartIndex, UriLength - StreamDataStartIndex, Data))
         {
             UE_LOG(LogglTFForUE4, Error, TEXT("Failed to decode the base64 data!"));
         }
     }
     else
     {
-        if (FFileHelper::LoadFileToArray(Data, *(InFileFolderRoot / InUri)))
+        const FString Uri = GLTF_GLTFSTRING_TO_TCHAR(InUri.c_str());
+        if (LoadFile(InFileFolderRoot / Uri))
         {
-            FilePath = InFileFolderRoot / InUri;
+            FilePath = InFileFolderRoot / Uri;
         }
     }
 }
 
+FglTFBufferData::FglTFBufferData(const FString& InFilePath, int64 InOffset, int64 InSize)
+    : Data()
+    , ViewData(nullptr)
+    , ViewSize(0)
+    , ViewDataOwner()
+    , FilePath(TEXT(""))
+    , StreamType(TEXT(""))
+    , StreamEncoding(TEXT(""))
+{
+    if (LoadFile(InFilePath, InOffset, InSize))
+    {
+        FilePath = InFilePath;
+    }
+}
+
 FglTFBufferData::~FglTFBufferData()
 {
-    //
+#if ENGINE_MINOR_VERSION <= 19
+#else
+    /// the region has to be released before the handle
+    MappedFileRegion.Reset();
+    MappedFileHandle.Reset();
+#endif
 }
 
 FglTFBufferData::operator bool() const
 {
-    return (Data.Num() > 0);
+    return (GetSize() > 0);
 }
 
-const TArray<uint8>& FglTFBufferData::GetData() const
+const uint8* FglTFBufferData::GetData() const
 {
-    return Data;
+    if (IsView())
+    {
+        /// pin the owner once, it may be released by another thread between a check and the use
+        const TSharedPtr<FglTFBufferDataOwner, ESPMode::ThreadSafe> DataOwner = ViewDataOwner.Pin();
+        return DataOwner.IsValid() ? ViewData : nullptr;
+    }
+#if ENGINE_MINOR_VERSION <= 19
+#else
+    if (MappedFileRegion.IsValid()) return MappedFileRegion->GetMappedPtr();
+#endif
+    return Data.GetData();
+}
+
+int64 FglTFBufferData::GetSize() const
+{
+    if (IsView())
+    {
+        const TSharedPtr<FglTFBufferDataOwner, ESPMode::ThreadSafe> DataOwner = ViewDataOwner.Pin();
+        return DataOwner.IsValid() ? ViewSize : 0;
+    }
+#if ENGINE_MINOR_VERSION <= 19
+#else
+    if (MappedFileRegion.IsValid()) return MappedFileRegion->GetMappedSize();
+#endif
+    return Data.Num();
 }
 
 bool FglTFBufferData::IsFromFile() const
@@ -188,44 +509,220 @@ bool FglTFBufferData::IsFromFile() const
     return !FilePath.IsEmpty();
 }
 
+bool FglTFBufferData::IsMappedFile() const
+{
+#if ENGINE_MINOR_VERSION <= 19
+    return false;
+#else
+    return MappedFileRegion.IsValid();
+#endif
+}
+
+bool FglTFBufferData::IsView() const
+{
+    return (ViewData != nullptr);
+}
+
 const FString& FglTFBufferData::GetFilePath() const
 {
     return FilePath;
 }
 
+bool FglTFBufferData::LoadFile(const FString& InFilePath, int64 InOffset /*= 0*/, int64 InSize /*= INDEX_NONE*/)
+{
+    if (InOffset < 0) return false;
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+#if ENGINE_MINOR_VERSION <= 19
+#else
+    /// the mapped region is not limited by the size of `TArray`
+    MappedFileHandle.Reset(PlatformFile.OpenMapped(*InFilePath));
+    if (MappedFileHandle.IsValid() && MappedFileHandle->GetFileSize() > 0)
+    {
+        const int64 FileSize = MappedFileHandle->GetFileSize();
+        const int64 MappedSize = (InSize < 0) ? (FileSize - InOffset) : InSize;
+        if (MappedSize > 0 && InOffset + MappedSize <= FileSize)
+        {
+            MappedFileRegion.Reset(MappedFileHandle->MapRegion(InOffset, MappedSize));
+            if (MappedFileRegion.IsValid() && MappedFileRegion->GetMappedPtr() != nullptr)
+            {
+                return true;
+            }
+        }
+    }
+    MappedFileRegion.Reset();
+    MappedFileHandle.Reset();
+    /// fall back to read the file if the platform can't map it
+#endif
+    if (InOffset == 0 && InSize < 0)
+    {
+        return FFileHelper::LoadFileToArray(Data, *InFilePath);
+    }
+
+    TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenRead(*InFilePath));
+    if (!FileHandle.IsValid()) return false;
+    const int64 FileSize = FileHandle->Size();
+    const int64 ReadSize = (InSize < 0) ? (FileSize - InOffset) : InSize;
+    if (ReadSize <= 0 || ReadSize > MAX_int32 || InOffset + ReadSize > FileSize) return false;
+    Data.SetNumUninitialized(static_cast<int32>(ReadSize));
+    if (!FileHandle->Seek(InOffset) || !FileHandle->Read(Data.GetData(), ReadSize))
+    {
+        Data.Empty();
+        return false;
+    }
+    return true;
+}
+
+FglTFAccessorDesc::FglTFAccessorDesc()
+    : Type(EglTFAccessorType::None)
+    , ComponentType(0)
+    , ElemSize(0)
+    , BufferIndex(INDEX_NONE)
+    , Offset(0)
+    , Stride(0)
+    , Count(0)
+    , bNormalized(false)
+    , bSparse(false)
+    , bValid(false)
+{
+    //
+}
+
+EglTFAccessorType::Type FglTFAccessorDesc::ToAccessorType(const libgltf::string_t& InType)
+{
+    if (InType == GLTF_TCHAR_TO_GLTFSTRING(TEXT("SCALAR"))) return EglTFAccessorType::Scalar;
+    if (InType == GLTF_TCHAR_TO_GLTFSTRING(TEXT("VEC2"))) return EglTFAccessorType::Vec2;
+    if (InType == GLTF_TCHAR_TO_GLTFSTRING(TEXT("VEC3"))) return EglTFAccessorType::Vec3;
+    if (InType == GLTF_TCHAR_TO_GLTFSTRING(TEXT("VEC4"))) return EglTFAccessorType::Vec4;
+    if (InType == GLTF_TCHAR_TO_GLTFSTRING(TEXT("MAT2"))) return EglTFAccessorType::Mat2;
+    if (InType == GLTF_TCHAR_TO_GLTFSTRING(TEXT("MAT3"))) return EglTFAccessorType::Mat3;
+    if (InType == GLTF_TCHAR_TO_GLTFSTRING(TEXT("MAT4"))) return EglTFAccessorType::Mat4;
+    return EglTFAccessorType::None;
+}
+
+int32 FglTFAccessorDesc::GetComponentNum(EglTFAccessorType::Type InType)
+{
+    switch (InType)
+    {
+    case EglTFAccessorType::Scalar: return 1;
+    case EglTFAccessorType::Vec2:   return 2;
+    case EglTFAccessorType::Vec3:   return 3;
+    case EglTFAccessorType::Vec4:   return 4;
+    case EglTFAccessorType::Mat2:   return 4;
+    case EglTFAccessorType::Mat3:   return 9;
+    case EglTFAccessorType::Mat4:   return 16;
+    default:                        break;
+    }
+    return 0;
+}
+
+int32 FglTFAccessorDesc::GetComponentSize(int32 InComponentType)
+{
+    switch (InComponentType)
+    {
+    case 5120:
+    case 5121:
+        return 1;
+
+    case 5122:
+    case 5123:
+        return 2;
+
+    case 5125:
+    case 5126:
+        return 4;
+
+    default:
+        break;
+    }
+    return 0;
+}
+
 FglTFBuffers::FglTFBuffers(bool InConstructByBinary /*= false*/)
     : bConstructByBinary(InConstructByBinary)
+    , bLazyLoading(false)
+    , LazyLoadingBudget(0)
+    , DataSources()
+    , DatasLock()
     , Datas()
-    , DataEmpty()
+    , LoadedDataIndices()
+    , LoadedDataSize(0)
+    , DataLastUses()
+    , DataUseCount(0)
+    , PrefetchingDatas()
+    , Accessors()
+    , DecodedAccessorsLock()
+    , AccessorReaders()
+    , DecodedAccessors()
+    , DracoCacheDirectory()
+    , DracoCacheMaxSize(0)
+    , DracoMeshDatasLock()
+    , DracoMeshDatas()
 {
     //
 }
 
 FglTFBuffers::~FglTFBuffers()
 {
-    //
+    FScopeLock DatasScopeLock(&DatasLock);
+    for (TPair<uint32, FPrefetchingData>& PrefetchingData : PrefetchingDatas)
+    {
+        PrefetchingData.Value.Data.Wait();
+    }
+    PrefetchingDatas.Empty();
 }
 
 bool FglTFBuffers::CacheBinary(uint32 InIndex, const TArray<uint8>& InData)
 {
     IndexToIndex[EglTFBufferSource::Buffers].Add(InIndex, Datas.Num());
-    Datas.Add(MakeShared<FglTFBufferData>(InData));
+    DataSources.AddDefaulted();
+    Datas.Add(MakeShared<FglTFBufferData, ESPMode::ThreadSafe>(InData));
+    return true;
+}
+
+bool FglTFBuffers::CacheBinary(uint32 InIndex, const uint8* InData, int64 InSize, const TSharedRef<FglTFBufferDataOwner, ESPMode::ThreadSafe>& InDataOwner)
+{
+    if (!InData || InSize <= 0) return false;
+    IndexToIndex[EglTFBufferSource::Buffers].Add(InIndex, Datas.Num());
+    DataSources.AddDefaulted();
+    Datas.Add(MakeShared<FglTFBufferData, ESPMode::ThreadSafe>(InData, InSize, InDataOwner));
+    return true;
+}
+
+bool FglTFBuffers::CacheBinary(uint32 InIndex, const FString& InFilePath, int64 InOffset, int64 InSize)
+{
+    if (InSize <= 0) return false;
+    TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> Data = MakeShared<FglTFBufferData, ESPMode::ThreadSafe>(InFilePath, InOffset, InSize);
+    if (!(*Data)) return false;
+    IndexToIndex[EglTFBufferSource::Buffers].Add(InIndex, Datas.Num());
+    DataSources.AddDefaulted();
+    Datas.Add(Data);
     return true;
 }
 
 bool FglTFBuffers::CacheImages(uint32 InIndex, const FString& InFileFolderRoot, const std::shared_ptr<libgltf::SImage>& InImage)
 {
     if (!InImage) return false;
+    /// the image is stored in a buffer view
+    if (InImage->uri.empty()) return false;
     IndexToIndex[EglTFBufferSource::Images].Add(InIndex, Datas.Num());
-    Datas.Add(MakeShared<FglTFBufferData>(InFileFolderRoot, GLTF_GLTFSTRING_TO_TCHAR(InImage->uri.c_str())));
+    FDataSource& DataSource = DataSources[DataSources.AddDefaulted()];
+    DataSource.FileFolderRoot = InFileFolderRoot;
+    DataSource.Uri = std::shared_ptr<const libgltf::string_t>(InImage, &InImage->uri);
+    Datas.Add(bLazyLoading ? TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe>() : MakeShared<FglTFBufferData, ESPMode::ThreadSafe>(DataSource.FileFolderRoot, *DataSource.Uri));
     return true;
 }
 
 bool FglTFBuffers::CacheBuffers(uint32 InIndex, const FString& InFileFolderRoot, const std::shared_ptr<libgltf::SBuffer>& InBuffer)
 {
     if (!InBuffer) return false;
+    /// the buffer is the BIN chunk of a glb file
+    if (InBuffer->uri.empty()) return false;
     IndexToIndex[EglTFBufferSource::Buffers].Add(InIndex, Datas.Num());
-    Datas.Add(MakeShared<FglTFBufferData>(InFileFolderRoot, GLTF_GLTFSTRING_TO_TCHAR(InBuffer->uri.c_str())));
+    FDataSource& DataSource = DataSources[DataSources.AddDefaulted()];
+    DataSource.FileFolderRoot = InFileFolderRoot;
+    DataSource.Uri = std::shared_ptr<const libgltf::string_t>(InBuffer, &InBuffer->uri);
+    Datas.Add(bLazyLoading ? TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe>() : MakeShared<FglTFBufferData, ESPMode::ThreadSafe>(DataSource.FileFolderRoot, *DataSource.Uri));
     return true;
 }
 
@@ -246,90 +743,442 @@ bool FglTFBuffers::Cache(const FString& InFileFolderRoot, const std::shared_ptr<
             CacheBuffers(Index++, InFileFolderRoot, Buffer);
         }
     }
-    return true;
+    return CacheAccessors(InglTF);
 }
 
-class FglTFBufferDecoder
+bool FglTFBuffers::CacheAccessors(const std::shared_ptr<libgltf::SGlTF>& InglTF)
 {
-    struct FDracoMeshPointIndices
+    Accessors.Empty();
     {
-        FDracoMeshPointIndices()
-            : Vertex(0)
-            , Normal(0)
-            , TexCoord(0)
-            , NewVertex(0)
+        FScopeLock DecodedAccessorsScopeLock(&DecodedAccessorsLock);
+        AccessorReaders.Empty();
+        DecodedAccessors.Empty();
+    }
+    if (!InglTF) return false;
+
+    Accessors.SetNum(static_cast<int32>(InglTF->accessors.size()));
+    for (int32 i = 0; i < Accessors.Num(); ++i)
+    {
+        const std::shared_ptr<libgltf::SAccessor>& Accessor = InglTF->accessors[i];
+        if (!Accessor) continue;
+
+        FglTFAccessorDesc& AccessorDesc = Accessors[i];
+        AccessorDesc.Type = FglTFAccessorDesc::ToAccessorType(Accessor->type);
+        AccessorDesc.ComponentType = Accessor->componentType;
+        AccessorDesc.ElemSize = FglTFAccessorDesc::GetComponentNum(AccessorDesc.Type) * FglTFAccessorDesc::GetComponentSize(AccessorDesc.ComponentType);
+        AccessorDesc.Stride = AccessorDesc.ElemSize;
+        AccessorDesc.Count = Accessor->count;
+        AccessorDesc.bNormalized = Accessor->normalized;
+        AccessorDesc.bSparse = !!Accessor->sparse;
+        if (AccessorDesc.ElemSize <= 0 || Accessor->count < 0)
         {
-            //
+            UE_LOG(LogglTFForUE4, Warning, TEXT("Invalid accessor(%d)!"), i);
+            continue;
         }
 
-        uint32 Vertex;
-        uint32 Normal;
-        uint32 TexCoord;
-        uint32 NewVertex;
-
-        bool operator==(const FDracoMeshPointIndices& InOther) const
+        if (!Accessor->bufferView)
         {
-            return InOther.Vertex == Vertex && InOther.Normal == Vertex && InOther.TexCoord == TexCoord;
+            AccessorDesc.bValid = true;
+            continue;
         }
-    };
 
-public:
-    template<uint32 TexCoordNumber, uint32 JointNumber>
-    static void GetAttributes(const libgltf::SKHR_draco_mesh_compressionextension* InExtensionDraco, const std::unique_ptr<draco::Mesh>& InDracoMesh, const draco::PointAttribute*& OutAttributePosition, const draco::PointAttribute*& OutAttributeNormal, const draco::PointAttribute*& OutAttributeColor, const draco::PointAttribute* OutAttributeTexCoords[TexCoordNumber], const draco::PointAttribute* OutAttributeJointsIndices[JointNumber + 1], const draco::PointAttribute* OutAttributeJointWeights[JointNumber + 1])
-    {
-        OutAttributePosition = nullptr;
-        OutAttributeNormal = nullptr;
-        OutAttributeColor = nullptr;
-        for (uint32 i = 0; i < TexCoordNumber; ++i)
+        const int32 BufferViewIndex = *Accessor->bufferView;
+        const std::shared_ptr<libgltf::SBufferView>& BufferView = (BufferViewIndex >= 0 && BufferViewIndex < static_cast<int32>(InglTF->bufferViews.size())) ? InglTF->bufferViews[BufferViewIndex] : nullptr;
+        const int32 BufferIndex = (BufferView && BufferView->buffer) ? (int32)(*BufferView->buffer) : INDEX_NONE;
+        if (BufferIndex < 0 || BufferIndex >= static_cast<int32>(InglTF->buffers.size()))
         {
-            OutAttributeTexCoords[i] = nullptr;
+            UE_LOG(LogglTFForUE4, Warning, TEXT("Invalid buffer view of the accessor(%d)!"), i);
+            continue;
         }
-        for (uint32 i = 0; i < JointNumber; ++i)
+
+        if (BufferView->byteStride > 0) AccessorDesc.Stride = BufferView->byteStride;
+        const std::shared_ptr<libgltf::SBuffer>& Buffer = InglTF->buffers[BufferIndex];
+        const int64 AccessorOffset = ToByteSize(Accessor->byteOffset);
+        const int64 BufferViewOffset = ToByteSize(BufferView->byteOffset);
+        const int64 BufferViewLength = ToByteSize(BufferView->byteLength);
+        if (AccessorDesc.Stride < AccessorDesc.ElemSize
+            || AccessorOffset + AccessorDesc.GetByteLength() > BufferViewLength
+            || (Buffer && BufferViewOffset + BufferViewLength > ToByteSize(Buffer->byteLength)))
         {
-            OutAttributeJointsIndices[i] = nullptr;
-            OutAttributeJointWeights[i] = nullptr;
+            UE_LOG(LogglTFForUE4, Warning, TEXT("The accessor(%d) is out of the buffer view(%d)!"), i, BufferViewIndex);
+            continue;
         }
-        if (!InExtensionDraco || !InDracoMesh) return;
 
-        typedef std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>> TAttributes;
+        AccessorDesc.BufferIndex = BufferIndex;
+        AccessorDesc.Offset = BufferViewOffset + AccessorOffset;
+        AccessorDesc.bValid = true;
+    }
+
+    /// nothing is shared until `CountAccessorReaders` counts the readers
+    FScopeLock DecodedAccessorsScopeLock(&DecodedAccessorsLock);
+    AccessorReaders.SetNumZeroed(Accessors.Num());
+    DecodedAccessors.SetNum(Accessors.Num());
+    return true;
+}
+
+namespace glTFImporter
+{
+    /// copy one element of a fixed size, the compilers turn it into one or two moves
+    template<int32 ElemSize>
+    FORCEINLINE void CopyElement(uint8* OutData, const uint8* InData)
+    {
+        FMemory::Memcpy(OutData, InData, ElemSize);
+    }
+
+#if GLTF_SIMD_SSE2 || GLTF_SIMD_NEON
+    template<>
+    FORCEINLINE void CopyElement<8>(uint8* OutData, const uint8* InData)
+    {
+#if GLTF_SIMD_SSE2
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(OutData), _mm_loadl_epi64(reinterpret_cast<const __m128i*>(InData)));
+#else
+        vst1_u8(OutData, vld1_u8(InData));
+#endif
+    }
+
+    template<>
+    FORCEINLINE void CopyElement<16>(uint8* OutData, const uint8* InData)
+    {
+#if GLTF_SIMD_SSE2
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(OutData), _mm_loadu_si128(reinterpret_cast<const __m128i*>(InData)));
+#else
+        vst1q_u8(OutData, vld1q_u8(InData));
+#endif
+    }
+#endif
 
+    /// `Stride` is 0 if it is only known at runtime, the fixed ones let the compilers unroll the loop
+    template<int32 ElemSize, int32 Stride>
+    void GatherFixed(uint8* OutData, const uint8* InData, int32 InStride, int32 InCount)
+    {
+        const int64 ActualStride = Stride > 0 ? Stride : InStride;
+        for (int32 i = 0; i < InCount; ++i, OutData += ElemSize, InData += ActualStride)
         {
-            const libgltf::string_t extension_attribute = GLTF_TCHAR_TO_GLTFSTRING(TEXT("POSITION"));
-            TAttributes::const_iterator AttributeCIt = InExtensionDraco->attributes.find(extension_attribute);
-            if (AttributeCIt != InExtensionDraco->attributes.cend())
-            {
-                int32_t UniqueId = *(AttributeCIt->second);
-                if (UniqueId >= 0)
-                {
-                    OutAttributePosition = InDracoMesh->GetAttributeByUniqueId(static_cast<uint32_t>(UniqueId));
-                }
-            }
-            else
-            {
-                OutAttributePosition = InDracoMesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
-            }
+            CopyElement<ElemSize>(OutData, InData);
         }
+    }
 
+    /// the 12 bytes elements are copied by 16 bytes, the stride is 16 bytes at least, so the load stays in the element's stride,
+    /// the extra 4 bytes written are overwritten by the next element, and the last element is copied by the scalar tail
+    template<int32 Stride>
+    void GatherFixed12(uint8* OutData, const uint8* InData, int32 InStride, int32 InCount)
+    {
+        const int64 ActualStride = Stride > 0 ? Stride : InStride;
+        checkSlow(ActualStride >= 16);
+        int32 i = 0;
+        for (; i + 1 < InCount; ++i, OutData += 12, InData += ActualStride)
         {
-            const libgltf::string_t extension_attribute = GLTF_TCHAR_TO_GLTFSTRING(TEXT("NORMAL"));
-            TAttributes::const_iterator AttributeCIt = InExtensionDraco->attributes.find(extension_attribute);
-            if (AttributeCIt != InExtensionDraco->attributes.cend())
-            {
-                int32_t UniqueId = *(AttributeCIt->second);
-                if (UniqueId >= 0)
-                {
-                    OutAttributeNormal = InDracoMesh->GetAttributeByUniqueId(static_cast<uint32_t>(UniqueId));
-                }
-            }
-            else
-            {
-                OutAttributeNormal = InDracoMesh->GetNamedAttribute(draco::GeometryAttribute::NORMAL);
-            }
+#if GLTF_SIMD_SSE2 || GLTF_SIMD_NEON
+            CopyElement<16>(OutData, InData);
+#else
+            CopyElement<12>(OutData, InData);
+#endif
+        }
+        if (i < InCount)
+        {
+            CopyElement<12>(OutData, InData);
         }
+    }
 
+    /// the interleaved layouts of the vertex attributes, like the position and normal in 24 bytes,
+    /// or the position, normal, and texcoord in 32 bytes
+    template<int32 ElemSize>
+    void GatherByStride(uint8* OutData, const uint8* InData, int32 InStride, int32 InCount)
+    {
+        switch (InStride)
         {
-            const libgltf::string_t extension_attribute = GLTF_TCHAR_TO_GLTFSTRING(TEXT("COLOR"));
-            TAttributes::const_iterator AttributeCIt = InExtensionDraco->attributes.find(extension_attribute);
+        case 16: GatherFixed<ElemSize, 16>(OutData, InData, InStride, InCount); break;
+        case 20: GatherFixed<ElemSize, 20>(OutData, InData, InStride, InCount); break;
+        case 24: GatherFixed<ElemSize, 24>(OutData, InData, InStride, InCount); break;
+        case 32: GatherFixed<ElemSize, 32>(OutData, InData, InStride, InCount); break;
+        case 48: GatherFixed<ElemSize, 48>(OutData, InData, InStride, InCount); break;
+        default: GatherFixed<ElemSize, 0>(OutData, InData, InStride, InCount); break;
+        }
+    }
+
+    void GatherByStride12(uint8* OutData, const uint8* InData, int32 InStride, int32 InCount)
+    {
+        switch (InStride)
+        {
+        case 16: GatherFixed12<16>(OutData, InData, InStride, InCount); break;
+        case 20: GatherFixed12<20>(OutData, InData, InStride, InCount); break;
+        case 24: GatherFixed12<24>(OutData, InData, InStride, InCount); break;
+        case 32: GatherFixed12<32>(OutData, InData, InStride, InCount); break;
+        case 48: GatherFixed12<48>(OutData, InData, InStride, InCount); break;
+        default: GatherFixed12<0>(OutData, InData, InStride, InCount); break;
+        }
+    }
+}
+
+void FglTFBuffers::Gather(uint8* OutData, const uint8* InData, int32 InElemSize, int32 InStride, int32 InCount)
+{
+    if (!OutData || !InData || InCount <= 0) return;
+    if (InStride == InElemSize)
+    {
+        FMemory::Memcpy(OutData, InData, static_cast<SIZE_T>(InElemSize) * InCount);
+        return;
+    }
+
+    /// specialize the common sizes of the vertex attributes, the interleaved strides are 4 bytes aligned
+    switch (InElemSize)
+    {
+    case 2:
+        glTFImporter::GatherByStride<2>(OutData, InData, InStride, InCount);
+        break;
+
+    case 4:
+        glTFImporter::GatherByStride<4>(OutData, InData, InStride, InCount);
+        break;
+
+    case 8:
+        glTFImporter::GatherByStride<8>(OutData, InData, InStride, InCount);
+        break;
+
+    case 12:
+        if (InStride >= 16)
+        {
+            glTFImporter::GatherByStride12(OutData, InData, InStride, InCount);
+        }
+        else
+        {
+            glTFImporter::GatherFixed<12, 0>(OutData, InData, InStride, InCount);
+        }
+        break;
+
+    case 16:
+        glTFImporter::GatherByStride<16>(OutData, InData, InStride, InCount);
+        break;
+
+    default:
+        for (int32 i = 0; i < InCount; ++i, OutData += InElemSize, InData += InStride)
+        {
+            FMemory::Memcpy(OutData, InData, InElemSize);
+        }
+        break;
+    }
+}
+
+void FglTFBuffers::SetLazyLoading(bool InLazyLoading, int64 InLazyLoadingBudget /*= 0*/)
+{
+    bLazyLoading = InLazyLoading;
+    LazyLoadingBudget = FMath::Max<int64>(InLazyLoadingBudget, 0);
+}
+
+void FglTFBuffers::Prefetch(bool InPrefetchImages, bool InPrefetchBuffers)
+{
+    FScopeLock DatasScopeLock(&DatasLock);
+
+    for (int32 SourceType = 0; SourceType < EglTFBufferSource::Max; ++SourceType)
+    {
+        if (SourceType == EglTFBufferSource::Images && !InPrefetchImages) continue;
+        if (SourceType == EglTFBufferSource::Buffers && !InPrefetchBuffers) continue;
+
+        for (const TPair<uint32, uint32>& IndexPair : IndexToIndex[SourceType])
+        {
+            const uint32 DataIndex = IndexPair.Value;
+            if (DataIndex >= static_cast<uint32>(Datas.Num())) continue;
+            if (Datas[DataIndex].IsValid() || PrefetchingDatas.Contains(DataIndex)) continue;
+
+            const FDataSource& DataSource = DataSources[DataIndex];
+            if (!DataSource.Uri || DataSource.Uri->empty()) continue;
+
+            /// count the size as soon as it is queued, so the prefetching never goes over the budget
+            const int64 DataSize = GetDataSourceSize(DataSource);
+            if (DataSize <= 0) continue;
+            if (LazyLoadingBudget > 0 && LoadedDataSize + DataSize > LazyLoadingBudget) continue;
+
+            const FString FileFolderRoot = DataSource.FileFolderRoot;
+            const std::shared_ptr<const libgltf::string_t> Uri = DataSource.Uri;
+            FPrefetchingData& PrefetchingData = PrefetchingDatas.Add(DataIndex);
+            PrefetchingData.Data = Async<TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe>>(EAsyncExecution::ThreadPool, [FileFolderRoot, Uri]() -> TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe>
+            {
+                return MakeShared<FglTFBufferData, ESPMode::ThreadSafe>(FileFolderRoot, *Uri);
+            }).Share();
+            PrefetchingData.Size = DataSize;
+            LoadedDataSize += DataSize;
+        }
+    }
+}
+
+TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> FglTFBuffers::GetDataByIndex(uint32 InDataIndex) const
+{
+    TSharedFuture<TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe>> PrefetchingData;
+    {
+        FScopeLock DatasScopeLock(&DatasLock);
+
+        if (InDataIndex >= static_cast<uint32>(Datas.Num())) return nullptr;
+        if (DataLastUses.Num() < Datas.Num())
+        {
+            DataLastUses.SetNumZeroed(Datas.Num());
+        }
+        DataLastUses[InDataIndex] = ++DataUseCount;
+
+        TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> Data = Datas[InDataIndex];
+        if (Data.IsValid()) return Data;
+
+        const FPrefetchingData* Prefetching = PrefetchingDatas.Find(InDataIndex);
+        if (!Prefetching)
+        {
+            const FDataSource& DataSource = DataSources[InDataIndex];
+            if (!DataSource.Uri || DataSource.Uri->empty()) return nullptr;
+
+            /// keep the data even if it is invalid, so it will not be loaded again
+            Data = MakeShared<FglTFBufferData, ESPMode::ThreadSafe>(DataSource.FileFolderRoot, *DataSource.Uri);
+            Datas[InDataIndex] = Data;
+            if (!(*Data)) return Data;
+
+            LoadedDataIndices.Add(InDataIndex);
+            LoadedDataSize += Data->GetSize();
+            ReleaseLeastRecentlyUsed(InDataIndex);
+            return Data;
+        }
+        PrefetchingData = Prefetching->Data;
+    }
+
+    /// wait for the one is needed without the lock, so the other threads still get the loaded datas
+    TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> Data = PrefetchingData.Get();
+
+    FScopeLock DatasScopeLock(&DatasLock);
+    FPrefetchingData Prefetched;
+    /// another thread waited for the same data and has stored it
+    if (!PrefetchingDatas.RemoveAndCopyValue(InDataIndex, Prefetched)) return Data;
+
+    LoadedDataSize -= Prefetched.Size;
+    Datas[InDataIndex] = Data;
+    if (!Data.IsValid() || !(*Data)) return Data;
+
+    if (bLazyLoading)
+    {
+        LoadedDataIndices.Add(InDataIndex);
+        LoadedDataSize += Data->GetSize();
+        ReleaseLeastRecentlyUsed(InDataIndex);
+    }
+    return Data;
+}
+
+int64 FglTFBuffers::GetDataSourceSize(const FDataSource& InDataSource)
+{
+    if (!InDataSource.Uri || InDataSource.Uri->empty()) return 0;
+
+    const int64 UriLength = static_cast<int64>(InDataSource.Uri->size());
+    FString StreamType, StreamEncoding;
+    const int64 StreamDataStartIndex = glTFImporter::ParseDataUri(InDataSource.Uri->c_str(), UriLength, StreamType, StreamEncoding);
+    if (StreamDataStartIndex != INDEX_NONE)
+    {
+        /// every four base64 characters are three bytes
+        return (UriLength - StreamDataStartIndex) / 4 * 3;
+    }
+    return IFileManager::Get().FileSize(*(InDataSource.FileFolderRoot / GLTF_GLTFSTRING_TO_TCHAR(InDataSource.Uri->c_str())));
+}
+
+void FglTFBuffers::ReleaseLeastRecentlyUsed(uint32 InDataIndexInUse) const
+{
+    if (LazyLoadingBudget <= 0 || LoadedDataSize <= LazyLoadingBudget) return;
+
+    /// the last uses are only sorted when something has to be released, the hits just stamp them
+    const TArray<uint64>& LastUses = DataLastUses;
+    LoadedDataIndices.Sort([&LastUses](uint32 InA, uint32 InB)
+    {
+        return LastUses[InA] < LastUses[InB];
+    });
+
+    /// the released data is still alive until its users finish it
+    TArray<uint32> KeptDataIndices;
+    KeptDataIndices.Reserve(LoadedDataIndices.Num());
+    for (const uint32 DataIndex : LoadedDataIndices)
+    {
+        if (DataIndex == InDataIndexInUse || LoadedDataSize <= LazyLoadingBudget)
+        {
+            KeptDataIndices.Add(DataIndex);
+            continue;
+        }
+        LoadedDataSize -= Datas[DataIndex]->GetSize();
+        Datas[DataIndex].Reset();
+    }
+    LoadedDataIndices = MoveTemp(KeptDataIndices);
+}
+
+class FglTFBufferDecoder
+{
+    struct FDracoMeshPointIndices
+    {
+        FDracoMeshPointIndices()
+            : Vertex(0)
+            , Normal(0)
+            , TexCoord(0)
+            , NewVertex(0)
+        {
+            //
+        }
+
+        uint32 Vertex;
+        uint32 Normal;
+        uint32 TexCoord;
+        uint32 NewVertex;
+
+        bool operator==(const FDracoMeshPointIndices& InOther) const
+        {
+            return InOther.Vertex == Vertex && InOther.Normal == Vertex && InOther.TexCoord == TexCoord;
+        }
+    };
+
+public:
+    template<uint32 TexCoordNumber, uint32 JointNumber>
+    static void GetAttributes(const libgltf::SKHR_draco_mesh_compressionextension* InExtensionDraco, const std::unique_ptr<draco::Mesh>& InDracoMesh, const draco::PointAttribute*& OutAttributePosition, const draco::PointAttribute*& OutAttributeNormal, const draco::PointAttribute*& OutAttributeColor, const draco::PointAttribute* OutAttributeTexCoords[TexCoordNumber], const draco::PointAttribute* OutAttributeJointsIndices[JointNumber + 1], const draco::PointAttribute* OutAttributeJointWeights[JointNumber + 1])
+    {
+        OutAttributePosition = nullptr;
+        OutAttributeNormal = nullptr;
+        OutAttributeColor = nullptr;
+        for (uint32 i = 0; i < TexCoordNumber; ++i)
+        {
+            OutAttributeTexCoords[i] = nullptr;
+        }
+        for (uint32 i = 0; i < JointNumber; ++i)
+        {
+            OutAttributeJointsIndices[i] = nullptr;
+            OutAttributeJointWeights[i] = nullptr;
+        }
+        if (!InExtensionDraco || !InDracoMesh) return;
+
+        typedef std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>> TAttributes;
+
+        {
+            const libgltf::string_t extension_attribute = GLTF_TCHAR_TO_GLTFSTRING(TEXT("POSITION"));
+            TAttributes::const_iterator AttributeCIt = InExtensionDraco->attributes.find(extension_attribute);
+            if (AttributeCIt != InExtensionDraco->attributes.cend())
+            {
+                int32_t UniqueId = *(AttributeCIt->second);
+                if (UniqueId >= 0)
+                {
+                    OutAttributePosition = InDracoMesh->GetAttributeByUniqueId(static_cast<uint32_t>(UniqueId));
+                }
+            }
+            else
+            {
+                OutAttributePosition = InDracoMesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+            }
+        }
+
+        {
+            const libgltf::string_t extension_attribute = GLTF_TCHAR_TO_GLTFSTRING(TEXT("NORMAL"));
+            TAttributes::const_iterator AttributeCIt = InExtensionDraco->attributes.find(extension_attribute);
+            if (AttributeCIt != InExtensionDraco->attributes.cend())
+            {
+                int32_t UniqueId = *(AttributeCIt->second);
+                if (UniqueId >= 0)
+                {
+                    OutAttributeNormal = InDracoMesh->GetAttributeByUniqueId(static_cast<uint32_t>(UniqueId));
+                }
+            }
+            else
+            {
+                OutAttributeNormal = InDracoMesh->GetNamedAttribute(draco::GeometryAttribute::NORMAL);
+            }
+        }
+
+        {
+            const libgltf::string_t extension_attribute = GLTF_TCHAR_TO_GLTFSTRING(TEXT("COLOR"));
+            TAttributes::const_iterator AttributeCIt = InExtensionDraco->attributes.find(extension_attribute);
             if (AttributeCIt != InExtensionDraco->attributes.cend())
             {
                 int32_t UniqueId = *(AttributeCIt->second);
@@ -549,24 +1398,32 @@ public:
     }
 
     template<typename TDracoData, uint32 ComponentNum, typename TEngineData, bool bSwapYZ, bool bInverseX>
-    static bool GetDatas(const draco::PointAttribute* const InPointAttribute, TArray<TEngineData>& OutDatas)
+    static bool GetDatas(const draco::PointAttribute* const InPointAttribute, uint32 InPointCount, TArray<TEngineData>& OutDatas)
     {
         OutDatas.Empty();
-        if (!InPointAttribute || InPointAttribute->num_components() <= 0) return false;
+        if (!InPointAttribute || InPointAttribute->num_components() <= 0 || InPointAttribute->size() <= 0) return false;
+        if (InPointAttribute->byte_stride() < static_cast<int64>(sizeof(TDracoData) * ComponentNum)) return false;
 
-        OutDatas.SetNumUninitialized(InPointAttribute->indices_map_size());
+        OutDatas.SetNumUninitialized(InPointCount);
 
+        /// read the values in the storage type directly, `TDracoData` is chosen by `data_type()`
+        const uint8* AttributeData = InPointAttribute->GetAddress(draco::AttributeValueIndex(0));
+        const int64 ByteStride = InPointAttribute->byte_stride();
+        const uint32 ValueCount = static_cast<uint32>(InPointAttribute->size());
+        const bool bIdentityMapping = InPointAttribute->is_mapping_identity();
         TDracoData DracoData[ComponentNum];
-        for (draco::PointIndex i(0); i < InPointAttribute->indices_map_size(); ++i)
+        for (uint32 i = 0; i < InPointCount; ++i)
         {
-            InPointAttribute->GetMappedValue(i, DracoData);
-            DracoDataToEngineData<TDracoData, ComponentNum, bSwapYZ, bInverseX>(DracoData, OutDatas[i.value()]);
+            const uint32 ValueIndex = bIdentityMapping ? i : InPointAttribute->mapped_index(draco::PointIndex(i)).value();
+            if (ValueIndex >= ValueCount) return false;
+            FMemory::Memcpy(DracoData, AttributeData + ValueIndex * ByteStride, sizeof(DracoData));
+            DracoDataToEngineData<TDracoData, ComponentNum, bSwapYZ, bInverseX>(DracoData, OutDatas[i]);
         }
         return true;
     }
 
     template<typename TDracoData, typename TEngineData, bool bSwapYZ, bool bInverseX>
-    static bool GetDatas(const draco::PointAttribute* const InPointAttribute, TArray<TEngineData>& OutDatas)
+    static bool GetDatas(const draco::PointAttribute* const InPointAttribute, uint32 InPointCount, TArray<TEngineData>& OutDatas)
     {
         OutDatas.Empty();
         if (!InPointAttribute || InPointAttribute->num_components() <= 0) return false;
@@ -574,16 +1431,16 @@ public:
         switch (InPointAttribute->num_components())
         {
         case 1:
-            return GetDatas<TDracoData, 1, TEngineData, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<TDracoData, 1, TEngineData, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case 2:
-            return GetDatas<TDracoData, 2, TEngineData, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<TDracoData, 2, TEngineData, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case 3:
-            return GetDatas<TDracoData, 3, TEngineData, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<TDracoData, 3, TEngineData, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case 4:
-            return GetDatas<TDracoData, 4, TEngineData, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<TDracoData, 4, TEngineData, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         default:
             break;
@@ -592,47 +1449,46 @@ public:
     }
 
     template<typename TEngineDataType, bool bSwapYZ, bool bInverseX>
-    static bool GetDatas(const draco::PointAttribute* const InPointAttribute, TArray<TEngineDataType>& OutDatas)
+    static bool GetDatas(const draco::PointAttribute* const InPointAttribute, uint32 InPointCount, TArray<TEngineDataType>& OutDatas)
     {
-        if (!InPointAttribute || InPointAttribute->indices_map_size() <= 0) return false;
         OutDatas.Empty();
+        if (!InPointAttribute || InPointCount == 0) return false;
 
-        uint32 DataMemorySize = 0;
         draco::DataType AttributeDataType = InPointAttribute->data_type();
         switch (AttributeDataType)
         {
         case draco::DT_BOOL:
-            return GetDatas<bool, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<bool, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_INT8:
-            return GetDatas<int8, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<int8, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_UINT8:
-            return GetDatas<uint8, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<uint8, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_INT16:
-            return GetDatas<int16, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<int16, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_UINT16:
-            return GetDatas<uint16, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<uint16, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_INT32:
-            return GetDatas<int32, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<int32, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_UINT32:
-            return GetDatas<uint32, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<uint32, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_FLOAT32:
-            return GetDatas<float, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<float, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_INT64:
-            return GetDatas<int64, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<int64, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_UINT64:
-            return GetDatas<uint64, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<uint64, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         case draco::DT_FLOAT64:
-            return GetDatas<double, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, OutDatas);
+            return GetDatas<double, TEngineDataType, bSwapYZ, bInverseX>(InPointAttribute, InPointCount, OutDatas);
 
         default:
             break;
@@ -641,12 +1497,12 @@ public:
     }
 
     template<uint32 TexCoordNumber, uint32 JointNumber, bool bSwapYZ, bool bInverseX>
-    static bool Decode(const FglTFBuffers& InBuffers, const libgltf::SKHR_draco_mesh_compressionextension* InExtensionDraco, const TArray<uint8>& InEncodedBuffer, TArray<uint32>& OutTriangleIndices, TArray<FVector>& OutVertexPositions, TArray<FVector>& OutVertexNormals, TArray<FVector4>& OutVertexTangents, TArray<FVector2D> OutVertexTexcoords[TexCoordNumber], TArray<FVector4> OutJointsIndices[JointNumber + 1], TArray<FVector4> OutJointWeights[JointNumber + 1])
+    static bool Decode(const FglTFBuffers& InBuffers, const libgltf::SKHR_draco_mesh_compressionextension* InExtensionDraco, const uint8* InEncodedData, int64 InEncodedSize, TArray<uint32>& OutTriangleIndices, TArray<FVector>& OutVertexPositions, TArray<FVector>& OutVertexNormals, TArray<FVector4>& OutVertexTangents, TArray<FVector2D> OutVertexTexcoords[TexCoordNumber], TArray<FVector4> OutJointsIndices[JointNumber + 1], TArray<FVector4> OutJointWeights[JointNumber + 1])
     {
         if (!InExtensionDraco) return false;
 
         draco::DecoderBuffer DracoDecoderBuffer;
-        DracoDecoderBuffer.Init((const char*)InEncodedBuffer.GetData(), InEncodedBuffer.GetAllocatedSize());
+        DracoDecoderBuffer.Init((const char*)InEncodedData, static_cast<size_t>(InEncodedSize));
         auto StatusOrGeometryType = draco::Decoder::GetEncodedGeometryType(&DracoDecoderBuffer);
         if (!StatusOrGeometryType.ok()) return false;
         if (StatusOrGeometryType.value() != draco::TRIANGULAR_MESH) return false;
@@ -665,32 +1521,29 @@ public:
 
         if (!DracoAttributePosition) return false;
 
-        TArray<uint32> PositionIndices;
-        OutTriangleIndices.SetNumUninitialized(DracoMesh->num_faces() * 3);
-        for (draco::FaceIndex i(0); i < DracoMesh->num_faces(); ++i)
+        /// the faces are stored as the point indices in a contiguous array
+        static_assert(sizeof(draco::Mesh::Face) == sizeof(uint32) * GLTF_TRIANGLE_POINTS_NUM, "The draco face should be three uint32!");
+        const uint32 FaceCount = DracoMesh->num_faces();
+        OutTriangleIndices.SetNumUninitialized(FaceCount * GLTF_TRIANGLE_POINTS_NUM);
+        if (FaceCount > 0)
         {
-            const draco::Mesh::Face& DracoFace = DracoMesh->face(i);
-
-            for (uint32 j = 0; j < 3; ++j)
-            {
-                const uint32 DracoPointAttributePositionIndex = DracoFace[j].value();
-                OutTriangleIndices[i.value() * 3 + j] = DracoPointAttributePositionIndex;
-                PositionIndices.AddUnique(DracoPointAttributePositionIndex);
-            }
+            FMemory::Memcpy(OutTriangleIndices.GetData(), &(DracoMesh->face(draco::FaceIndex(0))), sizeof(draco::Mesh::Face) * FaceCount);
         }
 
-        if (!GetDatas<FVector, bSwapYZ, bInverseX>(DracoAttributePosition, OutVertexPositions)) return false;
-        GetDatas<FVector, bSwapYZ, bInverseX>(DracoAttributeNormal, OutVertexNormals);
+        /// the identity mapped attributes don't have the indices map, so the points are counted by the mesh
+        const uint32 PointCount = DracoMesh->num_points();
+        if (!GetDatas<FVector, bSwapYZ, bInverseX>(DracoAttributePosition, PointCount, OutVertexPositions)) return false;
+        GetDatas<FVector, bSwapYZ, bInverseX>(DracoAttributeNormal, PointCount, OutVertexNormals);
         for (uint32 i = 0; i < TexCoordNumber; ++i)
         {
             const draco::PointAttribute* DracoAttributeTexCoord = DracoAttributeTexCoords[i];
-            GetDatas<FVector2D, bSwapYZ, bInverseX>(DracoAttributeTexCoord, OutVertexTexcoords[i]);
+            GetDatas<FVector2D, bSwapYZ, bInverseX>(DracoAttributeTexCoord, PointCount, OutVertexTexcoords[i]);
         }
 
         for (uint32 i = 0; i < JointNumber; ++i)
         {
-            GetDatas<FVector4, bSwapYZ, bInverseX>(DracoAttributeJointsIndices[i], OutJointsIndices[i]);
-            GetDatas<FVector4, bSwapYZ, bInverseX>(DracoAttributeJointWeights[i], OutJointWeights[i]);
+            GetDatas<FVector4, bSwapYZ, bInverseX>(DracoAttributeJointsIndices[i], PointCount, OutJointsIndices[i]);
+            GetDatas<FVector4, bSwapYZ, bInverseX>(DracoAttributeJointWeights[i], PointCount, OutJointWeights[i]);
         }
         return true;
     }
@@ -904,6 +1757,101 @@ bool FglTFImporter::SpawnStaticMeshActor(UWorld* InWorld, const FTransform& InTr
     return true;
 }
 
+bool FglTFImporter::SpawnInstancedStaticMeshActor(UWorld* InWorld, const TArray<FTransform>& InTransforms, UStaticMesh* InStaticMesh)
+{
+    if (!InWorld || InTransforms.Num() <= 0) return false;
+    AActor* InstancedStaticMeshActor = InWorld->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+    if (!InstancedStaticMeshActor) return false;
+    UHierarchicalInstancedStaticMeshComponent* InstancedStaticMeshComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstancedStaticMeshActor, NAME_None, RF_Transactional);
+    if (!InstancedStaticMeshComponent) return false;
+    InstancedStaticMeshComponent->SetStaticMesh(InStaticMesh);
+    InstancedStaticMeshActor->SetRootComponent(InstancedStaticMeshComponent);
+    InstancedStaticMeshActor->AddInstanceComponent(InstancedStaticMeshComponent);
+    /// add the instances before registering, so the render state and the tree are built once for all of them
+    for (const FTransform& Transform : InTransforms)
+    {
+        InstancedStaticMeshComponent->AddInstance(Transform);
+    }
+    InstancedStaticMeshComponent->RegisterComponent();
+    return true;
+}
+
+bool FglTFImporter::SpawnActors(UWorld* InWorld, const TArray<FglTFImporterSpawnRequest>& InSpawnRequests, ULevel* InLevel /*= nullptr*/)
+{
+    if (!InWorld) return false;
+    if (InSpawnRequests.Num() <= 0) return true;
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    /// the components are registered in `FinishSpawning`
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.bDeferConstruction = true;
+    SpawnParameters.OverrideLevel = InLevel;
+    TArray<AActor*> SpawnedActors;
+    SpawnedActors.SetNumZeroed(InSpawnRequests.Num());
+    for (int32 i = 0; i < InSpawnRequests.Num(); ++i)
+    {
+        const FglTFImporterSpawnRequest& SpawnRequest = InSpawnRequests[i];
+        if (SpawnRequest.StaticMesh && SpawnRequest.InstanceTransforms.Num() > 0)
+        {
+            AActor* InstancedStaticMeshActor = InWorld->SpawnActor<AActor>(AActor::StaticClass(), SpawnRequest.Transform, SpawnParameters);
+            if (!InstancedStaticMeshActor) continue;
+            UHierarchicalInstancedStaticMeshComponent* InstancedStaticMeshComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstancedStaticMeshActor, NAME_None, RF_Transactional);
+            InstancedStaticMeshComponent->SetStaticMesh(SpawnRequest.StaticMesh);
+            InstancedStaticMeshActor->SetRootComponent(InstancedStaticMeshComponent);
+            InstancedStaticMeshActor->AddInstanceComponent(InstancedStaticMeshComponent);
+            for (const FTransform& InstanceTransform : SpawnRequest.InstanceTransforms)
+            {
+                InstancedStaticMeshComponent->AddInstance(InstanceTransform);
+            }
+            SpawnedActors[i] = InstancedStaticMeshActor;
+        }
+        else if (SpawnRequest.StaticMesh)
+        {
+            AStaticMeshActor* StaticMeshActor = InWorld->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), SpawnRequest.Transform, SpawnParameters);
+            if (!StaticMeshActor || !StaticMeshActor->GetStaticMeshComponent()) continue;
+            StaticMeshActor->GetStaticMeshComponent()->SetStaticMesh(SpawnRequest.StaticMesh);
+            SpawnedActors[i] = StaticMeshActor;
+        }
+        else if (SpawnRequest.SkeletalMesh)
+        {
+            ASkeletalMeshActor* SkeletalMeshActor = InWorld->SpawnActor<ASkeletalMeshActor>(ASkeletalMeshActor::StaticClass(), SpawnRequest.Transform, SpawnParameters);
+            if (!SkeletalMeshActor || !SkeletalMeshActor->GetSkeletalMeshComponent()) continue;
+            SkeletalMeshActor->GetSkeletalMeshComponent()->SetSkeletalMesh(SpawnRequest.SkeletalMesh);
+            SpawnedActors[i] = SkeletalMeshActor;
+        }
+    }
+
+    /// a parent request is always added before its children
+    for (int32 i = 0; i < InSpawnRequests.Num(); ++i)
+    {
+        AActor* SpawnedActor = SpawnedActors[i];
+        if (!SpawnedActor) continue;
+        SpawnedActor->FinishSpawning(InSpawnRequests[i].Transform);
+
+        const int32 ParentRequestIndex = InSpawnRequests[i].ParentRequestIndex;
+        AActor* ParentActor = SpawnedActors.IsValidIndex(ParentRequestIndex) ? SpawnedActors[ParentRequestIndex] : nullptr;
+        if (!ParentActor) continue;
+
+        /// a static component can't be attached to a movable or stationary one, like the skeletal mesh component
+        USceneComponent* RootComponent = SpawnedActor->GetRootComponent();
+        USceneComponent* ParentRootComponent = ParentActor->GetRootComponent();
+        if (RootComponent && ParentRootComponent
+            && RootComponent->Mobility == EComponentMobility::Static && ParentRootComponent->Mobility != EComponentMobility::Static)
+        {
+            RootComponent->SetMobility(ParentRootComponent->Mobility);
+        }
+#if ENGINE_MINOR_VERSION <= 11
+        SpawnedActor->AttachRootComponentToActor(ParentActor, NAME_None, EAttachLocation::KeepWorldPosition);
+#else
+        SpawnedActor->AttachToActor(ParentActor, FAttachmentTransformRules::KeepWorldTransform);
+#endif
+    }
+
+    UE_LOG(LogglTFForUE4, Verbose, TEXT("Spawned %d actors in %.3f seconds"), InSpawnRequests.Num(), FPlatformTime::Seconds() - StartTime);
+    return true;
+}
+
 bool FglTFImporter::SpawnSkeletalMeshActor(UWorld* InWorld, const FTransform& InTransform, USkeletalMesh* InSkeletalMesh)
 {
     if (!InWorld) return false;
@@ -1151,405 +2099,1281 @@ namespace glTFImporter
         }
     };
 
-    template<typename TAccessorDataType, typename TEngineDataType, bool bSwapYZ, bool bInverseX>
-    bool GetAccessorData(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, const std::shared_ptr<libgltf::SAccessor>& InAccessor, TArray<TEngineDataType>& OutDataArray)
+    /// the scale of the normalized integer components, see `accessor.normalized` in the glTF spec
+    template<typename TComponent>
+    struct TNormalizedComponent
+    {
+        enum { bSigned = 0 };
+        static float Scale() { return 1.0f; }
+    };
+
+    template<> struct TNormalizedComponent<int8>    { enum { bSigned = 1 }; static float Scale() { return 1.0f / 127.0f; } };
+    template<> struct TNormalizedComponent<uint8>   { enum { bSigned = 0 }; static float Scale() { return 1.0f / 255.0f; } };
+    template<> struct TNormalizedComponent<int16>   { enum { bSigned = 1 }; static float Scale() { return 1.0f / 32767.0f; } };
+    template<> struct TNormalizedComponent<uint16>  { enum { bSigned = 0 }; static float Scale() { return 1.0f / 65535.0f; } };
+
+    /// loads the components of one element to the lanes of a vector register, the unused lanes are zeros
+    template<typename TComponent, int32 ComponentNum>
+    struct TComponentLoader
     {
-        if (!InAccessor || !InAccessor->bufferView)
+        static FORCEINLINE VectorRegister Load(const uint8* InData)
         {
-            UE_LOG(LogglTFForUE4, Error, TEXT("Invalid accessor!"));
-            return false;
+            /// the lanes are set in the registers, a store to the stack and a load back stalls the loop
+            return MakeVectorRegister(LoadComponent(InData, 0), LoadComponent(InData, 1), LoadComponent(InData, 2), LoadComponent(InData, 3));
         }
 
-        int32 BufferViewIndex = (*InAccessor->bufferView);
+        static FORCEINLINE float LoadComponent(const uint8* InData, int32 InIndex)
+        {
+            if (InIndex >= ComponentNum) return 0.0f;
+            /// the element may be not aligned in the buffer
+            TComponent Component;
+            FMemory::Memcpy(&Component, InData + InIndex * sizeof(TComponent), sizeof(TComponent));
+            return static_cast<float>(Component);
+        }
+    };
 
-        OutDataArray.Empty();
+    template<> struct TComponentLoader<float, 3> { static FORCEINLINE VectorRegister Load(const uint8* InData) { return VectorLoadFloat3_W0(InData); } };
+    template<> struct TComponentLoader<float, 4> { static FORCEINLINE VectorRegister Load(const uint8* InData) { return VectorLoad(InData); } };
+    template<> struct TComponentLoader<uint8, 4> { static FORCEINLINE VectorRegister Load(const uint8* InData) { return VectorLoadByte4(InData); } };
+    template<> struct TComponentLoader<int8, 4>  { static FORCEINLINE VectorRegister Load(const uint8* InData) { return VectorLoadSignedByte4(InData); } };
 
-        FString FilePath;
-        if (InAccessor->type == GLTF_TCHAR_TO_GLTFSTRING(TEXT("SCALAR")))
-        {
-            TArray<TAccessorTypeScale<TAccessorDataType>> AccessorDataArray;
-            if (InBuffers.GetBufferViewData<>(InGlTF, BufferViewIndex, AccessorDataArray, FilePath, InAccessor->byteOffset, InAccessor->count))
+    FORCEINLINE void StoreEngineData(const VectorRegister& InValue, FVector2D& OutEngineData)
+    {
+        float Components[4];
+        VectorStore(InValue, Components);
+        OutEngineData.X = Components[0];
+        OutEngineData.Y = Components[1];
+    }
+
+    FORCEINLINE void StoreEngineData(const VectorRegister& InValue, FVector& OutEngineData)
+    {
+        /// three stores of the lanes, `VectorStoreFloat3` goes through the stack
+        VectorStoreFloat1(InValue, &OutEngineData.X);
+        VectorStoreFloat1(VectorReplicate(InValue, 1), &OutEngineData.Y);
+        VectorStoreFloat1(VectorReplicate(InValue, 2), &OutEngineData.Z);
+    }
+
+    FORCEINLINE void StoreEngineData(const VectorRegister& InValue, FVector4& OutEngineData)
+    {
+        VectorStore(InValue, &OutEngineData);
+    }
+
+    FORCEINLINE void StoreEngineData(const VectorRegister& InValue, FQuat& OutEngineData)
+    {
+        VectorStore(InValue, &OutEngineData);
+    }
+
+    /// converts the elements of a view in vector registers, does the same as the conversion operators of `TAccessorType*`:
+    /// normalizes the integers, negates the x (or the w of a rotation) and swaps the y and z
+    template<typename TComponent, int32 ComponentNum, bool bSwapYZ, bool bNegateX, bool bNegateW, typename TAccessorType, typename TEngineDataType>
+    void ConvertAccessorViewKernel(const TglTFAccessorView<TAccessorType>& InAccessorView, bool bNormalized, TArray<TEngineDataType>& OutDatas)
+    {
+        const int32 Count = InAccessorView.Num();
+        const int32 Stride = InAccessorView.GetStride();
+        const uint8* Data = InAccessorView.GetData();
+        OutDatas.SetNumUninitialized(Count);
+        TEngineDataType* OutData = OutDatas.GetData();
+
+        const float NormalizedScale = bNormalized ? TNormalizedComponent<TComponent>::Scale() : 1.0f;
+        const bool bClampToMinusOne = bNormalized && TNormalizedComponent<TComponent>::bSigned;
+        const VectorRegister Scale = VectorSetFloat1(NormalizedScale);
+        const VectorRegister Sign = MakeVectorRegister(bNegateX ? -1.0f : 1.0f, 1.0f, 1.0f, bNegateW ? -1.0f : 1.0f);
+        const VectorRegister MinusOne = VectorSetFloat1(-1.0f);
+        for (int32 i = 0; i < Count; ++i, Data += Stride)
+        {
+            VectorRegister Value = VectorMultiply(TComponentLoader<TComponent, ComponentNum>::Load(Data), Scale);
+            if (bClampToMinusOne) Value = VectorMax(Value, MinusOne);
+            if (bNegateX || bNegateW) Value = VectorMultiply(Value, Sign);
+            if (bSwapYZ) Value = VectorSwizzle(Value, 0, 2, 1, 3);
+            StoreEngineData(Value, OutData[i]);
+        }
+    }
+
+    /// converts the vec3 of the bytes and the shorts without the vector registers, they have no vector load
+    /// and setting the lanes one by one is slower than the scalar conversion
+    template<typename TComponent, bool bSwapYZ, bool bNegateX, typename TAccessorType>
+    void ConvertAccessorViewScalar(const TglTFAccessorView<TAccessorType>& InAccessorView, bool bNormalized, TArray<FVector>& OutDatas)
+    {
+        const int32 Count = InAccessorView.Num();
+        const int32 Stride = InAccessorView.GetStride();
+        const uint8* Data = InAccessorView.GetData();
+        OutDatas.SetNumUninitialized(Count);
+        FVector* OutData = OutDatas.GetData();
+
+        const float NormalizedScale = TNormalizedComponent<TComponent>::Scale();
+        for (int32 i = 0; i < Count; ++i, Data += Stride)
+        {
+            /// the element may be not aligned in the buffer
+            TComponent Components[3];
+            FMemory::Memcpy(Components, Data, sizeof(Components));
+            float Values[3] = { static_cast<float>(Components[0]), static_cast<float>(Components[1]), static_cast<float>(Components[2]) };
+            if (bNormalized)
             {
-                for (const TAccessorTypeScale<TAccessorDataType>& AccessorDataItem : AccessorDataArray)
+                for (int32 j = 0; j < 3; ++j)
                 {
-                    OutDataArray.Add(AccessorDataItem);
+                    Values[j] *= NormalizedScale;
+                    if (TNormalizedComponent<TComponent>::bSigned && Values[j] < -1.0f) Values[j] = -1.0f;
                 }
             }
-            else
-            {
-                UE_LOG(LogglTFForUE4, Error, TEXT("Your glTF file has some errors?"));
-                return false;
-            }
-        }
-        else if (InAccessor->type == GLTF_TCHAR_TO_GLTFSTRING(TEXT("VEC2")))
-        {
-            TArray<TAccessorTypeVec2<TAccessorDataType, bSwapYZ, bInverseX>> AccessorDataArray;
-            if (InBuffers.GetBufferViewData<>(InGlTF, BufferViewIndex, AccessorDataArray, FilePath, InAccessor->byteOffset, InAccessor->count))
+            if (bNegateX) Values[0] = -Values[0];
+            if (bSwapYZ)
             {
-                for (const TAccessorTypeVec2<TAccessorDataType, bSwapYZ, bInverseX>& AccessorDataItem : AccessorDataArray)
-                {
-                    OutDataArray.Add(AccessorDataItem);
-                }
+                OutData[i] = FVector(Values[0], Values[2], Values[1]);
             }
             else
             {
-                UE_LOG(LogglTFForUE4, Error, TEXT("Your glTF file has some errors?"));
-                return false;
+                OutData[i] = FVector(Values[0], Values[1], Values[2]);
             }
         }
-        else if (InAccessor->type == GLTF_TCHAR_TO_GLTFSTRING(TEXT("VEC3")))
+    }
+
+    /// the other combinations, like the indices and the matrices, go through the conversion operators
+    template<typename TAccessorType, typename TEngineDataType>
+    void ConvertAccessorView(const TglTFAccessorView<TAccessorType>& InAccessorView, bool bNormalized, TArray<TEngineDataType>& OutDatas)
+    {
+        InAccessorView.ConvertTo(OutDatas);
+    }
+
+    /// a scalar fills one lane only, it is faster without the vector registers
+    template<typename TComponent>
+    void ConvertAccessorView(const TglTFAccessorView<TAccessorTypeScale<TComponent>>& InAccessorView, bool bNormalized, TArray<float>& OutDatas)
+    {
+        const int32 Count = InAccessorView.Num();
+        const int32 Stride = InAccessorView.GetStride();
+        const uint8* Data = InAccessorView.GetData();
+        OutDatas.SetNumUninitialized(Count);
+        float* OutData = OutDatas.GetData();
+
+        const float NormalizedScale = TNormalizedComponent<TComponent>::Scale();
+        for (int32 i = 0; i < Count; ++i, Data += Stride)
         {
-            TArray<TAccessorTypeVec3<TAccessorDataType, bSwapYZ, bInverseX>> AccessorDataArray;
-            if (InBuffers.GetBufferViewData<>(InGlTF, BufferViewIndex, AccessorDataArray, FilePath, InAccessor->byteOffset, InAccessor->count))
+            /// the element may be not aligned in the buffer
+            TComponent Component;
+            FMemory::Memcpy(&Component, Data, sizeof(TComponent));
+            OutData[i] = static_cast<float>(Component);
+            if (bNormalized)
             {
-                for (const TAccessorTypeVec3<TAccessorDataType, bSwapYZ, bInverseX>& AccessorDataItem : AccessorDataArray)
-                {
-                    OutDataArray.Add(AccessorDataItem);
-                }
-            }
-            else
-            {
-                UE_LOG(LogglTFForUE4, Error, TEXT("Your glTF file has some errors?"));
-                return false;
+                OutData[i] *= NormalizedScale;
+                if (TNormalizedComponent<TComponent>::bSigned && OutData[i] < -1.0f) OutData[i] = -1.0f;
             }
         }
-        else if (InAccessor->type == GLTF_TCHAR_TO_GLTFSTRING(TEXT("VEC4")))
-        {
-            TArray<TAccessorTypeVec4<TAccessorDataType, bSwapYZ, bInverseX>> AccessorDataArray;
-            if (InBuffers.GetBufferViewData<>(InGlTF, BufferViewIndex, AccessorDataArray, FilePath, InAccessor->byteOffset, InAccessor->count))
-            {
-                for (const TAccessorTypeVec4<TAccessorDataType, bSwapYZ, bInverseX>& AccessorDataItem : AccessorDataArray)
-                {
-                    OutDataArray.Add(AccessorDataItem);
-                }
-            }
-            else
+    }
+
+    template<typename TComponent, bool bSwapYZ, bool bInverseX>
+    void ConvertAccessorView(const TglTFAccessorView<TAccessorTypeVec2<TComponent, bSwapYZ, bInverseX>>& InAccessorView, bool bNormalized, TArray<FVector2D>& OutDatas)
+    {
+        /// a vec2 is never swapped
+        ConvertAccessorViewKernel<TComponent, 2, false, !bSwapYZ && bInverseX, false>(InAccessorView, bNormalized, OutDatas);
+    }
+
+    template<typename TComponent, bool bSwapYZ, bool bInverseX>
+    void ConvertAccessorView(const TglTFAccessorView<TAccessorTypeVec3<TComponent, bSwapYZ, bInverseX>>& InAccessorView, bool bNormalized, TArray<FVector>& OutDatas)
+    {
+        if (sizeof(TComponent) < sizeof(float))
+        {
+            ConvertAccessorViewScalar<TComponent, bSwapYZ, !bSwapYZ && bInverseX>(InAccessorView, bNormalized, OutDatas);
+        }
+        else
+        {
+            ConvertAccessorViewKernel<TComponent, 3, bSwapYZ, !bSwapYZ && bInverseX, false>(InAccessorView, bNormalized, OutDatas);
+        }
+    }
+
+    template<typename TComponent, bool bSwapYZ, bool bInverseX>
+    void ConvertAccessorView(const TglTFAccessorView<TAccessorTypeVec4<TComponent, bSwapYZ, bInverseX>>& InAccessorView, bool bNormalized, TArray<FVector4>& OutDatas)
+    {
+        ConvertAccessorViewKernel<TComponent, 4, bSwapYZ, !bSwapYZ && bInverseX, false>(InAccessorView, bNormalized, OutDatas);
+    }
+
+    template<typename TComponent, bool bSwapYZ, bool bInverseX>
+    void ConvertAccessorView(const TglTFAccessorView<TAccessorTypeVec4<TComponent, bSwapYZ, bInverseX>>& InAccessorView, bool bNormalized, TArray<FQuat>& OutDatas)
+    {
+        ConvertAccessorViewKernel<TComponent, 4, bSwapYZ, !bSwapYZ && bInverseX, bSwapYZ>(InAccessorView, bNormalized, OutDatas);
+    }
+
+    template<typename TIndex>
+    bool GetSparseIndices(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, const std::shared_ptr<libgltf::SAccessorSparse>& InSparse, TArray<uint32>& OutIndices)
+    {
+        FString FilePath;
+        TglTFAccessorView<TIndex> IndicesView;
+        if (!InBuffers.GetAccessorView(InGlTF, (int32)(*InSparse->indices->bufferView), FglTFBuffers::ToByteSize(InSparse->indices->byteOffset), InSparse->count, IndicesView, FilePath)) return false;
+        IndicesView.ConvertTo(OutIndices);
+        return true;
+    }
+
+    bool GetSparseIndices(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, const std::shared_ptr<libgltf::SAccessorSparse>& InSparse, TArray<uint32>& OutIndices)
+    {
+        if (!InSparse->indices || !InSparse->indices->bufferView) return false;
+
+        switch (InSparse->indices->componentType)
+        {
+        case 5121:
+            return GetSparseIndices<uint8>(InGlTF, InBuffers, InSparse, OutIndices);
+
+        case 5123:
+            return GetSparseIndices<uint16>(InGlTF, InBuffers, InSparse, OutIndices);
+
+        case 5125:
+            return GetSparseIndices<uint32>(InGlTF, InBuffers, InSparse, OutIndices);
+
+        default:
+            UE_LOG(LogglTFForUE4, Error, TEXT("Not support the sparse indices' componetType(%d)?"), InSparse->indices->componentType);
+            break;
+        }
+        return false;
+    }
+
+    /// the sparse accessor is kept sparse when it has no buffer view, otherwise it is applied on the buffer view
+    template<typename TAccessorType, typename TEngineDataType>
+    bool GetAccessorViewData(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, int32 InAccessorIndex, const FglTFAccessorDesc& InAccessorDesc, TglTFSparseArray<TEngineDataType>& OutSparseArray)
+    {
+        OutSparseArray.Reset();
+        OutSparseArray.Count = InAccessorDesc.Count;
+
+        const bool bHasBufferView = (InAccessorDesc.BufferIndex != INDEX_NONE);
+        FString FilePath;
+        if (bHasBufferView && InAccessorDesc.Count > 0)
+        {
+            TglTFAccessorView<TAccessorType> AccessorView;
+            if (!InBuffers.GetAccessorView(InAccessorDesc, AccessorView, FilePath))
             {
                 UE_LOG(LogglTFForUE4, Error, TEXT("Your glTF file has some errors?"));
                 return false;
             }
+            ConvertAccessorView(AccessorView, InAccessorDesc.bNormalized, OutSparseArray.Values);
         }
-        else if (InAccessor->type == GLTF_TCHAR_TO_GLTFSTRING(TEXT("MAT4")))
+
+        /// just the sparse accessors go back to the parsed glTF
+        const std::shared_ptr<libgltf::SAccessorSparse> Sparse = InAccessorDesc.bSparse ? InGlTF->accessors[InAccessorIndex]->sparse : nullptr;
+        if (!Sparse || Sparse->count <= 0)
         {
-            TArray<TAccessorTypeMat4x4<TAccessorDataType, bSwapYZ, bInverseX>> AccessorDataArray;
-            if (InBuffers.GetBufferViewData<>(InGlTF, BufferViewIndex, AccessorDataArray, FilePath, InAccessor->byteOffset, InAccessor->count))
+            if (!bHasBufferView)
             {
-                for (const TAccessorTypeMat4x4<TAccessorDataType, bSwapYZ, bInverseX>& AccessorDataItem : AccessorDataArray)
-                {
-                    OutDataArray.Add(AccessorDataItem);
-                }
+                /// all elements are zeros
+                OutSparseArray.Values.Init(TAccessorType(), InAccessorDesc.Count);
             }
-            else
+            return true;
+        }
+
+        TArray<uint32> SparseIndices;
+        TArray<TEngineDataType> SparseValues;
+        TglTFAccessorView<TAccessorType> SparseValuesView;
+        if (!GetSparseIndices(InGlTF, InBuffers, Sparse, SparseIndices)
+            || !Sparse->values || !Sparse->values->bufferView
+            || !InBuffers.GetAccessorView(InGlTF, (int32)(*Sparse->values->bufferView), FglTFBuffers::ToByteSize(Sparse->values->byteOffset), Sparse->count, SparseValuesView, FilePath))
+        {
+            UE_LOG(LogglTFForUE4, Error, TEXT("Your glTF file has some errors in the sparse accessor?"));
+            return false;
+        }
+        ConvertAccessorView(SparseValuesView, InAccessorDesc.bNormalized, SparseValues);
+        for (const uint32 SparseIndex : SparseIndices)
+        {
+            if (SparseIndex >= static_cast<uint32>(InAccessorDesc.Count))
             {
-                UE_LOG(LogglTFForUE4, Error, TEXT("Your glTF file has some errors?"));
+                UE_LOG(LogglTFForUE4, Error, TEXT("The sparse index(%u) is out of the accessor(%d)!"), SparseIndex, InAccessorDesc.Count);
                 return false;
             }
         }
+
+        if (bHasBufferView)
+        {
+            for (int32 i = 0; i < SparseIndices.Num(); ++i)
+            {
+                OutSparseArray.Values[SparseIndices[i]] = SparseValues[i];
+            }
+        }
+        else
+        {
+            OutSparseArray.Indices = MoveTemp(SparseIndices);
+            OutSparseArray.Values = MoveTemp(SparseValues);
+        }
+        return true;
+    }
+
+    template<typename TAccessorType, typename TEngineDataType>
+    bool GetAccessorViewData(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, int32 InAccessorIndex, const FglTFAccessorDesc& InAccessorDesc, TArray<TEngineDataType>& OutDataArray)
+    {
+        TglTFSparseArray<TEngineDataType> SparseArray;
+        if (!GetAccessorViewData<TAccessorType>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, SparseArray)) return false;
+        if (SparseArray.IsDense())
+        {
+            OutDataArray = MoveTemp(SparseArray.Values);
+        }
         else
         {
-            const FString AccessorType = GLTF_GLTFSTRING_TO_TCHAR(InAccessor->type.c_str());
-            UE_LOG(LogglTFForUE4, Error, TEXT("Not supports the accessor's type(%s)!"), *AccessorType);
+            SparseArray.ToDense(OutDataArray);
+        }
+        return true;
+    }
+
+    template<typename TEngineDataType> struct TEngineDataTypeId;
+    template<> struct TEngineDataTypeId<uint32>     { enum { Value = 1 }; };
+    template<> struct TEngineDataTypeId<float>      { enum { Value = 2 }; };
+    template<> struct TEngineDataTypeId<FVector2D>  { enum { Value = 3 }; };
+    template<> struct TEngineDataTypeId<FVector>    { enum { Value = 4 }; };
+    template<> struct TEngineDataTypeId<FVector4>   { enum { Value = 5 }; };
+    template<> struct TEngineDataTypeId<FQuat>      { enum { Value = 6 }; };
+    template<> struct TEngineDataTypeId<FMatrix>    { enum { Value = 7 }; };
+
+    /// the key of a decoded accessor in the same accessor, the target container, type and the flags
+    template<typename TOutDataType> struct TDecodeKey;
+    template<typename TEngineDataType> struct TDecodeKey<TArray<TEngineDataType>> { enum { Value = TEngineDataTypeId<TEngineDataType>::Value }; };
+    template<typename TEngineDataType> struct TDecodeKey<TglTFSparseArray<TEngineDataType>> { enum { Value = TEngineDataTypeId<TEngineDataType>::Value | (1 << 4) }; };
+
+    template<bool bSwapYZ, bool bInverseX, typename TOutDataType>
+    uint32 GetDecodeKey()
+    {
+        return static_cast<uint32>(TDecodeKey<TOutDataType>::Value) | (bSwapYZ ? (1 << 8) : 0) | (bInverseX ? (1 << 9) : 0);
+    }
+
+    template<typename TAccessorDataType, typename TEngineDataType, bool bSwapYZ, bool bInverseX, typename TOutDataType>
+    bool GetAccessorData(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, int32 InAccessorIndex, const FglTFAccessorDesc& InAccessorDesc, TOutDataType& OutData)
+    {
+        switch (InAccessorDesc.Type)
+        {
+        case EglTFAccessorType::Scalar:
+            return GetAccessorViewData<TAccessorTypeScale<TAccessorDataType>>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        case EglTFAccessorType::Vec2:
+            return GetAccessorViewData<TAccessorTypeVec2<TAccessorDataType, bSwapYZ, bInverseX>>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        case EglTFAccessorType::Vec3:
+            return GetAccessorViewData<TAccessorTypeVec3<TAccessorDataType, bSwapYZ, bInverseX>>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        case EglTFAccessorType::Vec4:
+            return GetAccessorViewData<TAccessorTypeVec4<TAccessorDataType, bSwapYZ, bInverseX>>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        case EglTFAccessorType::Mat4:
+            return GetAccessorViewData<TAccessorTypeMat4x4<TAccessorDataType, bSwapYZ, bInverseX>>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        default:
+            break;
+        }
+
+        const FString AccessorType = GLTF_GLTFSTRING_TO_TCHAR(InGlTF->accessors[InAccessorIndex]->type.c_str());
+        UE_LOG(LogglTFForUE4, Error, TEXT("Not supports the accessor's type(%s)!"), *AccessorType);
+        return false;
+    }
+
+    template<typename TEngineDataType, bool bSwapYZ, bool bInverseX, typename TOutDataType>
+    bool DecodeAccessorData(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, int32 InAccessorIndex, const FglTFAccessorDesc& InAccessorDesc, TOutDataType& OutData)
+    {
+        switch (InAccessorDesc.ComponentType)
+        {
+        case 5120:
+            return GetAccessorData<int8, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        case 5121:
+            return GetAccessorData<uint8, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        case 5122:
+            return GetAccessorData<int16, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        case 5123:
+            return GetAccessorData<uint16, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        case 5125:
+            return GetAccessorData<int32, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        case 5126:
+            return GetAccessorData<float, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessorIndex, InAccessorDesc, OutData);
+
+        default:
+            UE_LOG(LogglTFForUE4, Error, TEXT("Not support the accessor's componetType(%d)?"), InAccessorDesc.ComponentType);
+            break;
+        }
+        return false;
+    }
+
+    /// the accessor may be shared by some primitives or meshes, the decoded data is shared too without copying
+    template<typename TEngineDataType, bool bSwapYZ, bool bInverseX, typename TOutDataType>
+    bool GetSharedAccessorData(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, int32 InAccessorIndex, TSharedPtr<const TOutDataType, ESPMode::ThreadSafe>& OutData)
+    {
+        const FglTFAccessorDesc* AccessorDesc = InBuffers.GetAccessorDesc(InAccessorIndex);
+        if (!AccessorDesc || !AccessorDesc->bValid || (AccessorDesc->BufferIndex == INDEX_NONE && !AccessorDesc->bSparse))
+        {
+            UE_LOG(LogglTFForUE4, Error, TEXT("Invalid accessor(%d)!"), InAccessorIndex);
             return false;
         }
+
+        const uint32 DecodeKey = GetDecodeKey<bSwapYZ, bInverseX, TOutDataType>();
+        OutData = InBuffers.FindDecodedAccessor<TOutDataType>(InAccessorIndex, DecodeKey);
+        if (OutData.IsValid()) return true;
+
+        TSharedRef<TOutDataType, ESPMode::ThreadSafe> Decoded = MakeShareable(new TOutDataType());
+        if (!DecodeAccessorData<TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessorIndex, *AccessorDesc, *Decoded)) return false;
+        InBuffers.AddDecodedAccessor<TOutDataType>(InAccessorIndex, DecodeKey, Decoded);
+        OutData = Decoded;
         return true;
     }
 
-    template<typename TEngineDataType, bool bSwapYZ, bool bInverseX>
-    bool GetAccessorData(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, const std::shared_ptr<libgltf::SAccessor>& InAccessor, TArray<TEngineDataType>& OutDataArray)
+    /// the caller owns the data, it is copied from the shared one only if another reader decoded or still needs it
+    template<typename TEngineDataType, bool bSwapYZ, bool bInverseX, typename TOutDataType>
+    bool GetAccessorData(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, int32 InAccessorIndex, TOutDataType& OutData)
+    {
+        const FglTFAccessorDesc* AccessorDesc = InBuffers.GetAccessorDesc(InAccessorIndex);
+        if (!AccessorDesc || !AccessorDesc->bValid || (AccessorDesc->BufferIndex == INDEX_NONE && !AccessorDesc->bSparse))
+        {
+            UE_LOG(LogglTFForUE4, Error, TEXT("Invalid accessor(%d)!"), InAccessorIndex);
+            return false;
+        }
+
+        const uint32 DecodeKey = GetDecodeKey<bSwapYZ, bInverseX, TOutDataType>();
+        const TSharedPtr<const TOutDataType, ESPMode::ThreadSafe> SharedData = InBuffers.FindDecodedAccessor<TOutDataType>(InAccessorIndex, DecodeKey);
+        if (SharedData.IsValid())
+        {
+            OutData = *SharedData;
+            return true;
+        }
+        if (!InBuffers.HasDecodedAccessorReaders(InAccessorIndex))
+        {
+            return DecodeAccessorData<TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessorIndex, *AccessorDesc, OutData);
+        }
+
+        /// the other readers share the decoded one, the caller gets its own copy to change
+        TSharedRef<TOutDataType, ESPMode::ThreadSafe> Decoded = MakeShareable(new TOutDataType());
+        if (!DecodeAccessorData<TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessorIndex, *AccessorDesc, *Decoded)) return false;
+        InBuffers.AddDecodedAccessor<TOutDataType>(InAccessorIndex, DecodeKey, Decoded);
+        OutData = *Decoded;
+        return true;
+    }
+
+    template<bool bSwapYZ>
+    bool GetTriangleIndices(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive, const FglTFBuffers& InBuffers, TSharedPtr<const TArray<uint32>, ESPMode::ThreadSafe>& OutTriangleIndices)
+    {
+        if (!InGlTF || !InMeshPrimitive) return false;
+
+        return GetSharedAccessorData<uint32, bSwapYZ, false>(InGlTF, InBuffers, (int32)*(InMeshPrimitive->indices), OutTriangleIndices);
+    }
+
+    bool GetMorphTargetAccessorIndex(const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+        const libgltf::string_t& InKey,
+        int32 InTargetIndex,
+        int32& OutAccessorIndex)
     {
-        if (!InAccessor) return false;
+        if (static_cast<int32>(InMeshPrimitive->targets.size()) <= InTargetIndex) return false;
 
-        switch (InAccessor->componentType)
+        const std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>& MorphTargets = InMeshPrimitive->targets[InTargetIndex];
+        std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>::const_iterator MorphTargetIt = MorphTargets.find(InKey);
+        if (MorphTargetIt == MorphTargets.cend()) return false;
+        if (MorphTargetIt->second == nullptr) return false;
+        OutAccessorIndex = *MorphTargetIt->second;
+        return true;
+    }
+
+    template<bool bSwapYZ, bool bInverseX, typename TVertexPositions>
+    bool GetVertexPositions(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+        const FglTFBuffers& InBuffers,
+        TSharedPtr<const TVertexPositions, ESPMode::ThreadSafe>& OutVertexPositions,
+        int32 InTargetIndex = INDEX_NONE)
+    {
+        if (!InGlTF || !InMeshPrimitive) return false;
+        const libgltf::string_t get_key = GLTF_TCHAR_TO_GLTFSTRING(TEXT("POSITION"));
+        int32 AccessorIndex = INDEX_NONE;
+        if (InTargetIndex != INDEX_NONE)
+        {
+            if (!GetMorphTargetAccessorIndex(InMeshPrimitive, get_key, InTargetIndex, AccessorIndex)) return false;
+        }
+        else
+        {
+            if (InMeshPrimitive->attributes.find(get_key) == InMeshPrimitive->attributes.cend()) return true;
+            AccessorIndex = (int32)(*InMeshPrimitive->attributes.at(get_key));
+        }
+        if (static_cast<int32>(InGlTF->accessors.size()) <= AccessorIndex) return true;
+
+        return GetSharedAccessorData<FVector, bSwapYZ, bInverseX>(InGlTF, InBuffers, AccessorIndex, OutVertexPositions);
+    }
+
+    template<bool bSwapYZ, bool bInverseX, typename TVertexNormals>
+    bool GetVertexNormals(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+        const FglTFBuffers& InBuffers,
+        TSharedPtr<const TVertexNormals, ESPMode::ThreadSafe>& OutVertexNormals,
+        int32 InTargetIndex = -1)
+    {
+        if (!InGlTF || !InMeshPrimitive) return false;
+        const libgltf::string_t get_key = GLTF_TCHAR_TO_GLTFSTRING(TEXT("NORMAL"));
+        int32 AccessorIndex = INDEX_NONE;
+        if (InTargetIndex != INDEX_NONE)
+        {
+            if (!GetMorphTargetAccessorIndex(InMeshPrimitive, get_key, InTargetIndex, AccessorIndex)) return false;
+        }
+        else
+        {
+            if (InMeshPrimitive->attributes.find(get_key) == InMeshPrimitive->attributes.cend()) return true;
+            AccessorIndex = (int32)(*InMeshPrimitive->attributes.at(get_key));
+        }
+        if (static_cast<int32>(InGlTF->accessors.size()) <= AccessorIndex) return true;
+
+        return GetSharedAccessorData<FVector, bSwapYZ, bInverseX>(InGlTF, InBuffers, AccessorIndex, OutVertexNormals);
+    }
+
+    template<bool bSwapYZ, bool bInverseX, typename TVertexTangents>
+    bool GetVertexTangents(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+        const FglTFBuffers& InBuffers,
+        TSharedPtr<const TVertexTangents, ESPMode::ThreadSafe>& OutVertexTangents,
+        int32 InTargetIndex = -1)
+    {
+        if (!InGlTF || !InMeshPrimitive) return false;
+        const libgltf::string_t get_key = GLTF_TCHAR_TO_GLTFSTRING(TEXT("TANGENT"));
+        int32 AccessorIndex = INDEX_NONE;
+        if (InTargetIndex != INDEX_NONE)
+        {
+            if (!GetMorphTargetAccessorIndex(InMeshPrimitive, get_key, InTargetIndex, AccessorIndex)) return false;
+        }
+        else
+        {
+            if (InMeshPrimitive->attributes.find(get_key) == InMeshPrimitive->attributes.cend()) return true;
+            AccessorIndex = (int32)(*InMeshPrimitive->attributes.at(get_key));
+        }
+        if (static_cast<int32>(InGlTF->accessors.size()) <= AccessorIndex) return true;
+
+        return GetSharedAccessorData<FVector4, bSwapYZ, bInverseX>(InGlTF, InBuffers, AccessorIndex, OutVertexTangents);
+    }
+
+    template<int32 TexCoordNumber>
+    bool GetVertexTexcoords(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive, const FglTFBuffers& InBuffers, TSharedPtr<const TArray<FVector2D>, ESPMode::ThreadSafe> OutVertexTexcoords[TexCoordNumber])
+    {
+        if (!InGlTF || !InMeshPrimitive) return false;
+
+        for (int32 i = 0; i < TexCoordNumber; ++i)
+        {
+            OutVertexTexcoords[i].Reset();
+
+            const FString PrimitiveAttribute = FString::Printf(TEXT("TEXCOORD_%d"), i);
+            const libgltf::string_t primitive_attribute = GLTF_TCHAR_TO_GLTFSTRING(*PrimitiveAttribute);
+            if (InMeshPrimitive->attributes.find(primitive_attribute) == InMeshPrimitive->attributes.cend())
+            {
+                continue;
+            }
+
+            const int32 AccessorIndex = (int32)*(InMeshPrimitive->attributes.at(primitive_attribute));
+            if (GetSharedAccessorData<FVector2D, false, false>(InGlTF, InBuffers, AccessorIndex, OutVertexTexcoords[i]))
+            {
+                continue;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    template<bool bSwapYZ, bool bInverseX>
+    bool GetInverseBindMatrices(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SSkin>& InSkin, const FglTFBuffers& InBuffers, TArray<FMatrix>& OutInverseBindMatrices)
+    {
+        if (!InGlTF || !InSkin || !InSkin->inverseBindMatrices) return false;
+
+        return GetAccessorData<FMatrix, bSwapYZ, bInverseX>(InGlTF, InBuffers, (int32)*(InSkin->inverseBindMatrices), OutInverseBindMatrices);
+    }
+
+    bool GetJointIndices(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive, int32 InIndex, const FglTFBuffers& InBuffers, TSharedPtr<const TArray<FVector4>, ESPMode::ThreadSafe>& OutJointIndices)
+    {
+        if (!InGlTF || !InMeshPrimitive) return false;
+        const libgltf::string_t JointName = GLTF_TCHAR_TO_GLTFSTRING(*FString::Printf(TEXT("JOINTS_%d"), InIndex));
+        if (InMeshPrimitive->attributes.find(JointName) == InMeshPrimitive->attributes.cend()) return true;
+
+        return GetSharedAccessorData<FVector4, false, false>(InGlTF, InBuffers, (int32)*(InMeshPrimitive->attributes.at(JointName)), OutJointIndices);
+    }
+
+    bool GetJointWeights(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive, int32 InIndex, const FglTFBuffers& InBuffers, TSharedPtr<const TArray<FVector4>, ESPMode::ThreadSafe>& OutJointWeights)
+    {
+        if (!InGlTF || !InMeshPrimitive) return false;
+        const libgltf::string_t JointName = GLTF_TCHAR_TO_GLTFSTRING(*FString::Printf(TEXT("WEIGHTS_%d"), InIndex));
+        if (InMeshPrimitive->attributes.find(JointName) == InMeshPrimitive->attributes.cend()) return true;
+
+        return GetSharedAccessorData<FVector4, false, false>(InGlTF, InBuffers, (int32)*(InMeshPrimitive->attributes.at(JointName)), OutJointWeights);
+    }
+
+    const libgltf::SKHR_draco_mesh_compressionextension* GetDracoExtension(const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive)
+    {
+        if (!InMeshPrimitive) return nullptr;
+        const std::shared_ptr<libgltf::SExtension>& Extensions = InMeshPrimitive->extensions;
+        const libgltf::string_t extension_property = GLTF_TCHAR_TO_GLTFSTRING(TEXT("KHR_draco_mesh_compression"));
+        if (!Extensions || (Extensions->properties.find(extension_property) == Extensions->properties.end())) return nullptr;
+        return (const libgltf::SKHR_draco_mesh_compressionextension*)Extensions->properties[extension_property].get();
+    }
+
+    template<typename TData>
+    TSharedPtr<const TData, ESPMode::ThreadSafe> MakeSharedData(TData& InOutData)
+    {
+        if (InOutData.Num() <= 0) return nullptr;
+        return MakeShareable(new TData(MoveTemp(InOutData)));
+    }
+
+    template<int32 TexCoordNumber, int32 JointNumber, bool bSwapYZ, bool bInverseX>
+    bool GetMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+        const FglTFBuffers& InBuffers,
+        FglTFMeshData& OutMeshData)
+    {
+        static_assert(TexCoordNumber <= MAX_TEXCOORDS && JointNumber <= GLTF_JOINT_LAYERS_NUM_MAX, "Too many attributes for the mesh data!");
+
+        /// clean up
+        OutMeshData = FglTFMeshData();
+
+        if (!InGlTF || !InMeshPrimitive) return false;
+
+        const libgltf::SKHR_draco_mesh_compressionextension* ExtensionDraco = GetDracoExtension(InMeshPrimitive);
+        if (ExtensionDraco)
+        {
+            /// take the primitive decoded by `FglTFBuffers::DecodeDracoMeshes`, or decode it here
+            FglTFDracoMeshData DracoMeshData;
+            if (!InBuffers.FindDracoMeshData(InMeshPrimitive.get(), bSwapYZ, DracoMeshData)
+                && !InBuffers.DecodeDracoMesh(InGlTF, ExtensionDraco, bSwapYZ, DracoMeshData))
+            {
+                return false;
+            }
+
+            /// the draco mesh data belongs to this primitive only, it is moved in
+            OutMeshData.TriangleIndices = MakeSharedData(DracoMeshData.TriangleIndices);
+            OutMeshData.VertexPositions = MakeSharedData(DracoMeshData.VertexPositions);
+            OutMeshData.VertexNormals = MakeSharedData(DracoMeshData.VertexNormals);
+            for (uint32 i = 0; i < TexCoordNumber; ++i)
+            {
+                OutMeshData.VertexTexcoords[i] = MakeSharedData(DracoMeshData.VertexTexcoords[i]);
+            }
+            for (uint32 i = 0; i < JointNumber; ++i)
+            {
+                OutMeshData.JointsIndices[i] = MakeSharedData(DracoMeshData.JointsIndices[i]);
+                OutMeshData.JointsWeights[i] = MakeSharedData(DracoMeshData.JointWeights[i]);
+            }
+        }
+        else
+        {
+            /// the attributes are independent reads of the buffers, so they are decoded concurrently and joined here
+            TArray<TFunction<bool()>> DecodeTasks;
+            DecodeTasks.Emplace([&]() { return GetTriangleIndices<bSwapYZ>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData.TriangleIndices); });
+            DecodeTasks.Emplace([&]() { return GetVertexPositions<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData.VertexPositions); });
+            DecodeTasks.Emplace([&]() { return GetVertexNormals<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData.VertexNormals); });
+            DecodeTasks.Emplace([&]() { return GetVertexTangents<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData.VertexTangents); });
+
+            /// only `POSITION`, `NORMAL`, and `TANGENT` supported for morph target
+            const int32 MorphTargetCount = static_cast<int32>(InMeshPrimitive->targets.size());
+            OutMeshData.MorphTargetsVertexPositions.SetNum(MorphTargetCount);
+            OutMeshData.MorphTargetsVertexNormals.SetNum(MorphTargetCount);
+            OutMeshData.MorphTargetsVertexTangents.SetNum(MorphTargetCount);
+            for (int32 i = 0; i < MorphTargetCount; ++i)
+            {
+                DecodeTasks.Emplace([&, i]()
+                {
+                    if (!GetVertexPositions<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData.MorphTargetsVertexPositions[i], i))
+                    {
+                        OutMeshData.MorphTargetsVertexPositions[i].Reset();
+                    }
+                    return true;
+                });
+                DecodeTasks.Emplace([&, i]()
+                {
+                    if (!GetVertexNormals<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData.MorphTargetsVertexNormals[i], i))
+                    {
+                        OutMeshData.MorphTargetsVertexNormals[i].Reset();
+                    }
+                    return true;
+                });
+                DecodeTasks.Emplace([&, i]()
+                {
+                    if (!GetVertexTangents<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData.MorphTargetsVertexTangents[i], i))
+                    {
+                        OutMeshData.MorphTargetsVertexTangents[i].Reset();
+                    }
+                    return true;
+                });
+            }
+
+            DecodeTasks.Emplace([&]() { return GetVertexTexcoords<TexCoordNumber>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData.VertexTexcoords); });
+
+            for (int32 i = 0; i < JointNumber; ++i)
+            {
+                DecodeTasks.Emplace([&, i]() { GetJointIndices(InGlTF, InMeshPrimitive, i, InBuffers, OutMeshData.JointsIndices[i]); return true; });
+                DecodeTasks.Emplace([&, i]() { GetJointWeights(InGlTF, InMeshPrimitive, i, InBuffers, OutMeshData.JointsWeights[i]); return true; });
+            }
+
+            int32 VertexCount = 0;
+            {
+                const libgltf::string_t position_key = GLTF_TCHAR_TO_GLTFSTRING(TEXT("POSITION"));
+                std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>::const_iterator PositionIt = InMeshPrimitive->attributes.find(position_key);
+                const FglTFAccessorDesc* PositionAccessorDesc = (PositionIt != InMeshPrimitive->attributes.cend() && PositionIt->second) ? InBuffers.GetAccessorDesc(*PositionIt->second) : nullptr;
+                if (PositionAccessorDesc) VertexCount = PositionAccessorDesc->Count;
+            }
+
+            TArray<bool> DecodeResults;
+            DecodeResults.Init(false, DecodeTasks.Num());
+            ParallelFor(DecodeTasks.Num(), [&DecodeTasks, &DecodeResults](int32 InTaskIndex)
+            {
+                DecodeResults[InTaskIndex] = DecodeTasks[InTaskIndex]();
+            }, VertexCount * (MorphTargetCount + 1) < GglTFParallelDecodeVerticesMin);
+            if (DecodeResults.Contains(false))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+namespace glTFImporter
+{
+    template<typename TComponent, bool bSwapYZ, bool bInverseX, typename TEngineDataType> struct TEngineAccessorType;
+    template<typename TComponent, bool bSwapYZ, bool bInverseX> struct TEngineAccessorType<TComponent, bSwapYZ, bInverseX, float>       { typedef TAccessorTypeScale<TComponent> Type; };
+    template<typename TComponent, bool bSwapYZ, bool bInverseX> struct TEngineAccessorType<TComponent, bSwapYZ, bInverseX, FVector2D>   { typedef TAccessorTypeVec2<TComponent, bSwapYZ, bInverseX> Type; };
+    template<typename TComponent, bool bSwapYZ, bool bInverseX> struct TEngineAccessorType<TComponent, bSwapYZ, bInverseX, FVector>     { typedef TAccessorTypeVec3<TComponent, bSwapYZ, bInverseX> Type; };
+    template<typename TComponent, bool bSwapYZ, bool bInverseX> struct TEngineAccessorType<TComponent, bSwapYZ, bInverseX, FVector4>    { typedef TAccessorTypeVec4<TComponent, bSwapYZ, bInverseX> Type; };
+    template<typename TComponent, bool bSwapYZ, bool bInverseX> struct TEngineAccessorType<TComponent, bSwapYZ, bInverseX, FQuat>       { typedef TAccessorTypeVec4<TComponent, bSwapYZ, bInverseX> Type; };
+
+    template<typename TComponent, bool bSwapYZ, bool bInverseX, typename TEngineDataType>
+    void ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, bool bNormalized, bool bPerElement, TArray<TEngineDataType>& OutDatas)
+    {
+        const TglTFAccessorView<typename TEngineAccessorType<TComponent, bSwapYZ, bInverseX, TEngineDataType>::Type> AccessorView(TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe>(), InData, InStride, InCount);
+        if (bPerElement)
+        {
+            AccessorView.ConvertTo(OutDatas);
+        }
+        else
+        {
+            ConvertAccessorView(AccessorView, bNormalized, OutDatas);
+        }
+    }
+
+    template<typename TComponent, typename TEngineDataType>
+    void ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<TEngineDataType>& OutDatas)
+    {
+        if (bSwapYZ && bInverseX) ConvertAccessorElements<TComponent, true, true>(InData, InStride, InCount, bNormalized, bPerElement, OutDatas);
+        else if (bSwapYZ) ConvertAccessorElements<TComponent, true, false>(InData, InStride, InCount, bNormalized, bPerElement, OutDatas);
+        else if (bInverseX) ConvertAccessorElements<TComponent, false, true>(InData, InStride, InCount, bNormalized, bPerElement, OutDatas);
+        else ConvertAccessorElements<TComponent, false, false>(InData, InStride, InCount, bNormalized, bPerElement, OutDatas);
+    }
+
+    template<typename TEngineDataType>
+    bool ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<TEngineDataType>& OutDatas)
+    {
+        if (!InData || InCount < 0) return false;
+        switch (InComponentType)
         {
         case 5120:
-            return GetAccessorData<int8, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessor, OutDataArray);
+            ConvertAccessorElements<int8>(InData, InStride, InCount, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+            return true;
 
         case 5121:
-            return GetAccessorData<uint8, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessor, OutDataArray);
+            ConvertAccessorElements<uint8>(InData, InStride, InCount, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+            return true;
 
         case 5122:
-            return GetAccessorData<int16, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessor, OutDataArray);
+            ConvertAccessorElements<int16>(InData, InStride, InCount, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+            return true;
 
         case 5123:
-            return GetAccessorData<uint16, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessor, OutDataArray);
+            ConvertAccessorElements<uint16>(InData, InStride, InCount, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+            return true;
 
         case 5125:
-            return GetAccessorData<int32, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessor, OutDataArray);
+            ConvertAccessorElements<int32>(InData, InStride, InCount, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+            return true;
 
         case 5126:
-            return GetAccessorData<float, TEngineDataType, bSwapYZ, bInverseX>(InGlTF, InBuffers, InAccessor, OutDataArray);
+            ConvertAccessorElements<float>(InData, InStride, InCount, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+            return true;
 
         default:
-            UE_LOG(LogglTFForUE4, Error, TEXT("Not support the accessor's componetType(%d)?"), InAccessor->componentType);
+            UE_LOG(LogglTFForUE4, Error, TEXT("Not support the accessor's componetType(%d)?"), InComponentType);
             break;
         }
         return false;
     }
+}
+
+bool FglTFImporter::ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<float>& OutDatas)
+{
+    return glTFImporter::ConvertAccessorElements(InData, InStride, InCount, InComponentType, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+}
+
+bool FglTFImporter::ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<FVector2D>& OutDatas)
+{
+    return glTFImporter::ConvertAccessorElements(InData, InStride, InCount, InComponentType, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+}
+
+bool FglTFImporter::ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<FVector>& OutDatas)
+{
+    return glTFImporter::ConvertAccessorElements(InData, InStride, InCount, InComponentType, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+}
+
+bool FglTFImporter::ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<FVector4>& OutDatas)
+{
+    return glTFImporter::ConvertAccessorElements(InData, InStride, InCount, InComponentType, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+}
+
+bool FglTFImporter::ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<FQuat>& OutDatas)
+{
+    return glTFImporter::ConvertAccessorElements(InData, InStride, InCount, InComponentType, bNormalized, bSwapYZ, bInverseX, bPerElement, OutDatas);
+}
+
+namespace glTFImporter
+{
+    /// the nodes of the scene trees in depth first order, each node is visited once
+    void GetSceneNodeIndices(const std::shared_ptr<libgltf::SGlTF>& InglTF, bool InAllScenes, TArray<int32>& OutNodeIndices)
+    {
+        OutNodeIndices.Empty();
+        if (!InglTF) return;
+
+        TArray<int32> NodeIndices;
+        for (int32 i = 0; i < static_cast<int32>(InglTF->scenes.size()); ++i)
+        {
+            if (!InAllScenes && InglTF->scene && i != (int32)(*InglTF->scene)) continue;
+            const std::shared_ptr<libgltf::SScene>& Scene = InglTF->scenes[i];
+            if (!Scene) continue;
+            for (const std::shared_ptr<libgltf::SGlTFId>& NodeId : Scene->nodes)
+            {
+                if (!NodeId) continue;
+                NodeIndices.Add((int32)(*NodeId));
+            }
+        }
+
+        TArray<bool> NodeVisited;
+        NodeVisited.Init(false, static_cast<int32>(InglTF->nodes.size()));
+        while (NodeIndices.Num() > 0)
+        {
+            const int32 NodeIndex = NodeIndices.Pop(false);
+            if (!NodeVisited.IsValidIndex(NodeIndex) || NodeVisited[NodeIndex]) continue;
+            NodeVisited[NodeIndex] = true;
+            OutNodeIndices.Add(NodeIndex);
+
+            const std::shared_ptr<libgltf::SNode>& Node = InglTF->nodes[NodeIndex];
+            if (!Node) continue;
+            for (const std::shared_ptr<libgltf::SGlTFId>& ChildId : Node->children)
+            {
+                if (!ChildId) continue;
+                NodeIndices.Add((int32)(*ChildId));
+            }
+        }
+    }
+}
+
+void FglTFBuffers::CountAccessorReaders(const std::shared_ptr<libgltf::SGlTF>& InglTF, bool InAllScenes, bool InMeshes, bool InSkins, bool InAnimations)
+{
+    FScopeLock DecodedAccessorsScopeLock(&DecodedAccessorsLock);
+    for (int32& AccessorReader : AccessorReaders)
+    {
+        AccessorReader = 0;
+    }
+    for (TArray<TPair<uint32, TSharedPtr<const FglTFDecodedAccessor, ESPMode::ThreadSafe>>>& DecodedAccessor : DecodedAccessors)
+    {
+        DecodedAccessor.Empty();
+    }
+    if (!InglTF) return;
+
+    auto AddReader = [this](const std::shared_ptr<libgltf::SGlTFId>& InAccessorIndex)
+    {
+        if (!InAccessorIndex) return;
+        const int32 AccessorIndex = *InAccessorIndex;
+        if (AccessorReaders.IsValidIndex(AccessorIndex)) ++AccessorReaders[AccessorIndex];
+    };
+    auto AddAttributeReader = [&AddReader](const std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>& InAttributes, const TCHAR* InAttributeName)
+    {
+        std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>::const_iterator AttributeIt = InAttributes.find(GLTF_TCHAR_TO_GLTFSTRING(InAttributeName));
+        if (AttributeIt != InAttributes.cend()) AddReader(AttributeIt->second);
+    };
+
+    TArray<int32> NodeIndices;
+    glTFImporter::GetSceneNodeIndices(InglTF, InAllScenes, NodeIndices);
+
+    /// only the attributes `GetMeshData` reads, a mesh is counted once even if some nodes refer to it
+    TArray<bool> MeshVisited;
+    MeshVisited.Init(false, static_cast<int32>(InglTF->meshes.size()));
+    TArray<bool> SkinVisited;
+    SkinVisited.Init(false, static_cast<int32>(InglTF->skins.size()));
+    for (const int32 NodeIndex : NodeIndices)
+    {
+        const std::shared_ptr<libgltf::SNode>& Node = InglTF->nodes[NodeIndex];
+        if (!Node || !InMeshes || !Node->mesh) continue;
+
+        const bool bSkinned = InSkins && Node->skin;
+        if (bSkinned)
+        {
+            const int32 SkinIndex = *(Node->skin);
+            if (SkinVisited.IsValidIndex(SkinIndex) && !SkinVisited[SkinIndex] && InglTF->skins[SkinIndex])
+            {
+                SkinVisited[SkinIndex] = true;
+                AddReader(InglTF->skins[SkinIndex]->inverseBindMatrices);
+            }
+        }
+
+        const int32 MeshIndex = *(Node->mesh);
+        if (!MeshVisited.IsValidIndex(MeshIndex) || MeshVisited[MeshIndex]) continue;
+        MeshVisited[MeshIndex] = true;
+
+        const std::shared_ptr<libgltf::SMesh>& Mesh = InglTF->meshes[MeshIndex];
+        if (!Mesh) continue;
+        for (const std::shared_ptr<libgltf::SMeshPrimitive>& MeshPrimitive : Mesh->primitives)
+        {
+            /// the draco primitives are decoded from their own buffer views
+            if (!MeshPrimitive || glTFImporter::GetDracoExtension(MeshPrimitive)) continue;
+
+            AddReader(MeshPrimitive->indices);
+            AddAttributeReader(MeshPrimitive->attributes, TEXT("POSITION"));
+            AddAttributeReader(MeshPrimitive->attributes, TEXT("NORMAL"));
+            AddAttributeReader(MeshPrimitive->attributes, TEXT("TANGENT"));
+            for (int32 i = 0; i < MAX_TEXCOORDS; ++i)
+            {
+                AddAttributeReader(MeshPrimitive->attributes, *FString::Printf(TEXT("TEXCOORD_%d"), i));
+            }
+            for (int32 i = 0; bSkinned && i < GLTF_JOINT_LAYERS_NUM_MAX; ++i)
+            {
+                AddAttributeReader(MeshPrimitive->attributes, *FString::Printf(TEXT("JOINTS_%d"), i));
+                AddAttributeReader(MeshPrimitive->attributes, *FString::Printf(TEXT("WEIGHTS_%d"), i));
+            }
+            for (const std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>& MorphTarget : MeshPrimitive->targets)
+            {
+                AddAttributeReader(MorphTarget, TEXT("POSITION"));
+                AddAttributeReader(MorphTarget, TEXT("NORMAL"));
+                AddAttributeReader(MorphTarget, TEXT("TANGENT"));
+            }
+        }
+    }
+
+    if (!InAnimations) return;
+    for (const std::shared_ptr<libgltf::SAnimation>& Animation : InglTF->animations)
+    {
+        if (!Animation) continue;
+        for (const std::shared_ptr<libgltf::SAnimationSampler>& AnimationSampler : Animation->samplers)
+        {
+            if (!AnimationSampler) continue;
+            AddReader(AnimationSampler->input);
+            AddReader(AnimationSampler->output);
+        }
+    }
+}
+
+FglTFDracoMeshData::FglTFDracoMeshData()
+    : bSwapYZ(true)
+{
+    //
+}
+
+void FglTFBuffers::DecodeDracoMeshes(const std::shared_ptr<libgltf::SGlTF>& InglTF, bool InAllScenes, bool bSwapYZ /*= true*/)
+{
+    {
+        FScopeLock DracoMeshDatasScopeLock(&DracoMeshDatasLock);
+        DracoMeshDatas.Empty();
+    }
+    if (!InglTF) return;
+
+    TArray<int32> NodeIndices;
+    glTFImporter::GetSceneNodeIndices(InglTF, InAllScenes, NodeIndices);
 
-    template<bool bSwapYZ>
-    bool GetTriangleIndices(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive, const FglTFBuffers& InBuffers, TArray<uint32>& OutTriangleIndices)
+    /// collect the draco primitives of the meshes in the node trees
+    TArray<bool> MeshVisited;
+    MeshVisited.Init(false, static_cast<int32>(InglTF->meshes.size()));
+    TArray<const libgltf::SMeshPrimitive*> MeshPrimitives;
+    TArray<const libgltf::SKHR_draco_mesh_compressionextension*> ExtensionDracos;
+    for (const int32 NodeIndex : NodeIndices)
     {
-        if (!InGlTF || !InMeshPrimitive) return false;
+        const std::shared_ptr<libgltf::SNode>& Node = InglTF->nodes[NodeIndex];
+        if (!Node || !Node->mesh) continue;
+        const int32 MeshIndex = *(Node->mesh);
+        if (!MeshVisited.IsValidIndex(MeshIndex) || MeshVisited[MeshIndex]) continue;
+        MeshVisited[MeshIndex] = true;
 
-        const std::shared_ptr<libgltf::SAccessor>& Accessor = InGlTF->accessors[(int32)*(InMeshPrimitive->indices)];
-        return GetAccessorData<uint32, bSwapYZ, false>(InGlTF, InBuffers, Accessor, OutTriangleIndices);
+        const std::shared_ptr<libgltf::SMesh>& Mesh = InglTF->meshes[MeshIndex];
+        if (!Mesh) continue;
+        for (const std::shared_ptr<libgltf::SMeshPrimitive>& MeshPrimitive : Mesh->primitives)
+        {
+            const libgltf::SKHR_draco_mesh_compressionextension* ExtensionDraco = glTFImporter::GetDracoExtension(MeshPrimitive);
+            if (!ExtensionDraco) continue;
+            MeshPrimitives.Add(MeshPrimitive.get());
+            ExtensionDracos.Add(ExtensionDraco);
+        }
     }
+    if (MeshPrimitives.Num() <= 0) return;
 
-    bool GetMorphTargetAccessorIndex(const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
-        const libgltf::string_t& InKey,
-        int32 InTargetIndex,
-        int32& OutAccessorIndex)
+    /// each primitive has its own decoder, the failed one is decoded again when the mesh is constructed
+    TArray<TSharedPtr<FglTFDracoMeshData, ESPMode::ThreadSafe>> DecodedMeshDatas;
+    DecodedMeshDatas.SetNum(MeshPrimitives.Num());
+    ParallelFor(MeshPrimitives.Num(), [this, &InglTF, bSwapYZ, &ExtensionDracos, &DecodedMeshDatas](int32 InPrimitiveIndex)
     {
-        if (static_cast<int32>(InMeshPrimitive->targets.size()) <= InTargetIndex) return false;
+        TSharedPtr<FglTFDracoMeshData, ESPMode::ThreadSafe> DracoMeshData = MakeShared<FglTFDracoMeshData, ESPMode::ThreadSafe>();
+        if (DecodeDracoMesh(InglTF, ExtensionDracos[InPrimitiveIndex], bSwapYZ, *DracoMeshData))
+        {
+            DecodedMeshDatas[InPrimitiveIndex] = DracoMeshData;
+        }
+    });
 
-        const std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>& MorphTargets = InMeshPrimitive->targets[InTargetIndex];
-        std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>::const_iterator MorphTargetIt = MorphTargets.find(InKey);
-        if (MorphTargetIt == MorphTargets.cend()) return false;
-        if (MorphTargetIt->second == nullptr) return false;
-        OutAccessorIndex = *MorphTargetIt->second;
-        return true;
+    /// all primitives of this import are saved now
+    TrimDracoCache();
+
+    FScopeLock DracoMeshDatasScopeLock(&DracoMeshDatasLock);
+    for (int32 i = 0; i < MeshPrimitives.Num(); ++i)
+    {
+        if (!DecodedMeshDatas[i].IsValid()) continue;
+        DracoMeshDatas.Add(MeshPrimitives[i], DecodedMeshDatas[i]);
     }
+}
 
-    template<bool bSwapYZ, bool bInverseX>
-    bool GetVertexPositions(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
-        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
-        const FglTFBuffers& InBuffers,
-        TArray<FVector>& OutVertexPositions,
-        int32 InTargetIndex = INDEX_NONE)
+namespace glTFImporter
+{
+    /// change it when the layout of the cached draco mesh data is changed
+    static const uint32 DracoMeshDataCacheMagic = 0x6F636164;
+    static const uint32 DracoMeshDataCacheVersion = 1;
+
+    FString GetDracoMeshDataCacheKey(const libgltf::SKHR_draco_mesh_compressionextension* InExtensionDraco, const TglTFAccessorView<uint8>& InEncodedView, bool bSwapYZ)
     {
-        if (!InGlTF || !InMeshPrimitive) return false;
-        const libgltf::string_t get_key = GLTF_TCHAR_TO_GLTFSTRING(TEXT("POSITION"));
-        int32 AccessorIndex = INDEX_NONE;
-        if (InTargetIndex != INDEX_NONE)
-        {
-            if (!GetMorphTargetAccessorIndex(InMeshPrimitive, get_key, InTargetIndex, AccessorIndex)) return false;
-        }
-        else
+        FSHA1 HashState;
+        HashState.Update((const uint8*)&DracoMeshDataCacheVersion, sizeof(DracoMeshDataCacheVersion));
+        HashState.Update(InEncodedView.GetData(), static_cast<uint32>(InEncodedView.Num()));
+        /// the unique ids of the attributes and the axis conversion change the decoded data too
+        for (const std::pair<const libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>& Attribute : InExtensionDraco->attributes)
         {
-            if (InMeshPrimitive->attributes.find(get_key) == InMeshPrimitive->attributes.cend()) return true;
-            AccessorIndex = (int32)(*InMeshPrimitive->attributes[get_key]);
+            const int32 UniqueId = Attribute.second ? (int32)(*Attribute.second) : INDEX_NONE;
+            HashState.Update((const uint8*)Attribute.first.data(), static_cast<uint32>(Attribute.first.size() * sizeof(libgltf::string_t::value_type)));
+            HashState.Update((const uint8*)&UniqueId, sizeof(UniqueId));
         }
-        if (static_cast<int32>(InGlTF->accessors.size()) <= AccessorIndex) return true;
+        const uint8 SwapYZ = bSwapYZ ? 1 : 0;
+        HashState.Update(&SwapYZ, sizeof(SwapYZ));
+        HashState.Final();
 
-        const std::shared_ptr<libgltf::SAccessor>& Accessor = InGlTF->accessors[AccessorIndex];
-        return GetAccessorData<FVector, bSwapYZ, bInverseX>(InGlTF, InBuffers, Accessor, OutVertexPositions);
+        uint8 Hash[FSHA1::DigestSize];
+        HashState.GetHash(Hash);
+        return BytesToHex(Hash, FSHA1::DigestSize);
     }
 
-    template<bool bSwapYZ, bool bInverseX>
-    bool GetVertexNormals(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
-        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
-        const FglTFBuffers& InBuffers,
-        TArray<FVector>& OutVertexNormals,
-        int32 InTargetIndex = -1)
+    void SerializeDracoMeshData(FArchive& InArchive, FglTFDracoMeshData& InOutDracoMeshData)
     {
-        if (!InGlTF || !InMeshPrimitive) return false;
-        const libgltf::string_t get_key = GLTF_TCHAR_TO_GLTFSTRING(TEXT("NORMAL"));
-        int32 AccessorIndex = INDEX_NONE;
-        if (InTargetIndex != INDEX_NONE)
+        InArchive << InOutDracoMeshData.TriangleIndices;
+        InArchive << InOutDracoMeshData.VertexPositions;
+        InArchive << InOutDracoMeshData.VertexNormals;
+        for (int32 i = 0; i < MAX_TEXCOORDS; ++i)
         {
-            if (!GetMorphTargetAccessorIndex(InMeshPrimitive, get_key, InTargetIndex, AccessorIndex)) return false;
+            InArchive << InOutDracoMeshData.VertexTexcoords[i];
         }
-        else
+        for (int32 i = 0; i < GLTF_JOINT_LAYERS_NUM_MAX; ++i)
         {
-            if (InMeshPrimitive->attributes.find(get_key) == InMeshPrimitive->attributes.cend()) return true;
-            AccessorIndex = (int32)(*InMeshPrimitive->attributes[get_key]);
+            InArchive << InOutDracoMeshData.JointsIndices[i];
+            InArchive << InOutDracoMeshData.JointWeights[i];
         }
-        if (static_cast<int32>(InGlTF->accessors.size()) <= AccessorIndex) return true;
-
-        const std::shared_ptr<libgltf::SAccessor>& Accessor = InGlTF->accessors[AccessorIndex];
-        return GetAccessorData<FVector, bSwapYZ, bInverseX>(InGlTF, InBuffers, Accessor, OutVertexNormals);
     }
 
-    template<bool bSwapYZ, bool bInverseX>
-    bool GetVertexTangents(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
-        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
-        const FglTFBuffers& InBuffers,
-        TArray<FVector4>& OutVertexTangents,
-        int32 InTargetIndex = -1)
+    /// the cached file may be corrupted or written by another version, so the mesh is checked before using it
+    bool IsDracoMeshDataValid(const FglTFDracoMeshData& InDracoMeshData)
     {
-        if (!InGlTF || !InMeshPrimitive) return false;
-        const libgltf::string_t get_key = GLTF_TCHAR_TO_GLTFSTRING(TEXT("TANGENT"));
-        int32 AccessorIndex = INDEX_NONE;
-        if (InTargetIndex != INDEX_NONE)
+        const int32 VertexCount = InDracoMeshData.VertexPositions.Num();
+        if (VertexCount <= 0) return false;
+        if ((InDracoMeshData.TriangleIndices.Num() % GLTF_TRIANGLE_POINTS_NUM) != 0) return false;
+        for (const uint32 TriangleIndex : InDracoMeshData.TriangleIndices)
         {
-            if (!GetMorphTargetAccessorIndex(InMeshPrimitive, get_key, InTargetIndex, AccessorIndex)) return false;
+            if (TriangleIndex >= static_cast<uint32>(VertexCount)) return false;
         }
-        else
+
+        /// each attribute is empty or has one value for each vertex
+        if (InDracoMeshData.VertexNormals.Num() > 0 && InDracoMeshData.VertexNormals.Num() != VertexCount) return false;
+        for (int32 i = 0; i < MAX_TEXCOORDS; ++i)
         {
-            if (InMeshPrimitive->attributes.find(get_key) == InMeshPrimitive->attributes.cend()) return true;
-            AccessorIndex = (int32)(*InMeshPrimitive->attributes[get_key]);
+            if (InDracoMeshData.VertexTexcoords[i].Num() > 0 && InDracoMeshData.VertexTexcoords[i].Num() != VertexCount) return false;
         }
-        if (static_cast<int32>(InGlTF->accessors.size()) <= AccessorIndex) return true;
-
-        const std::shared_ptr<libgltf::SAccessor>& Accessor = InGlTF->accessors[AccessorIndex];
-        return GetAccessorData<FVector4, bSwapYZ, bInverseX>(InGlTF, InBuffers, Accessor, OutVertexTangents);
+        for (int32 i = 0; i < GLTF_JOINT_LAYERS_NUM_MAX; ++i)
+        {
+            if (InDracoMeshData.JointsIndices[i].Num() > 0 && InDracoMeshData.JointsIndices[i].Num() != VertexCount) return false;
+            if (InDracoMeshData.JointWeights[i].Num() > 0 && InDracoMeshData.JointWeights[i].Num() != VertexCount) return false;
+        }
+        return true;
     }
 
-    template<int32 TexCoordNumber>
-    bool GetVertexTexcoords(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive, const FglTFBuffers& InBuffers, TArray<FVector2D> OutVertexTexcoords[TexCoordNumber])
+    bool LoadDracoMeshData(const FString& InFilePath, FglTFDracoMeshData& OutDracoMeshData)
     {
-        if (!InGlTF || !InMeshPrimitive) return false;
+        TArray<uint8> CachedData;
+        if (!FFileHelper::LoadFileToArray(CachedData, *InFilePath, FILEREAD_Silent)) return false;
 
-        for (int32 i = 0; i < TexCoordNumber; ++i)
+        FMemoryReader CachedDataReader(CachedData);
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        CachedDataReader << Magic;
+        CachedDataReader << Version;
+        if (Magic != DracoMeshDataCacheMagic || Version != DracoMeshDataCacheVersion) return false;
+        SerializeDracoMeshData(CachedDataReader, OutDracoMeshData);
+        if (CachedDataReader.IsError() || !IsDracoMeshDataValid(OutDracoMeshData))
         {
-            OutVertexTexcoords[i].Empty();
+            UE_LOG(LogglTFForUE4, Warning, TEXT("The cached draco mesh data is invalid, decode it again - %s"), *InFilePath);
+            return false;
+        }
 
-            const FString PrimitiveAttribute = FString::Printf(TEXT("TEXCOORD_%d"), i);
-            const libgltf::string_t primitive_attribute = GLTF_TCHAR_TO_GLTFSTRING(*PrimitiveAttribute);
-            if (InMeshPrimitive->attributes.find(primitive_attribute) == InMeshPrimitive->attributes.cend())
-            {
-                continue;
-            }
+        /// the modification time is the last use, the oldest files are deleted at first by `FglTFBuffers::TrimDracoCache`
+        IFileManager::Get().SetTimeStamp(*InFilePath, FDateTime::UtcNow());
+        return true;
+    }
 
-            const std::shared_ptr<libgltf::SAccessor>& Accessor = InGlTF->accessors[(int32)*(InMeshPrimitive->attributes[primitive_attribute])];
-            if (GetAccessorData<FVector2D, false, false>(InGlTF, InBuffers, Accessor, OutVertexTexcoords[i]))
-            {
-                continue;
-            }
+    bool SaveDracoMeshData(const FString& InFilePath, FglTFDracoMeshData& InDracoMeshData)
+    {
+        TArray<uint8> CachedData;
+        FMemoryWriter CachedDataWriter(CachedData);
+        uint32 Magic = DracoMeshDataCacheMagic;
+        uint32 Version = DracoMeshDataCacheVersion;
+        CachedDataWriter << Magic;
+        CachedDataWriter << Version;
+        SerializeDracoMeshData(CachedDataWriter, InDracoMeshData);
+
+        /// write a temporary file at first, another import may read the same one
+        const FString TempFilePath = FString::Printf(TEXT("%s.%s.tmp"), *InFilePath, *FGuid::NewGuid().ToString());
+        if (!FFileHelper::SaveArrayToFile(CachedData, *TempFilePath)) return false;
+        if (!IFileManager::Get().Move(*InFilePath, *TempFilePath, true, true, false, true))
+        {
+            IFileManager::Get().Delete(*TempFilePath, false, false, true);
             return false;
         }
         return true;
     }
+}
 
-    template<bool bSwapYZ, bool bInverseX>
-    bool GetInverseBindMatrices(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SSkin>& InSkin, const FglTFBuffers& InBuffers, TArray<FMatrix>& OutInverseBindMatrices)
-    {
-        if (!InGlTF || !InSkin || !InSkin->inverseBindMatrices) return false;
+void FglTFBuffers::SetDracoCacheDirectory(const FString& InDracoCacheDirectory, int64 InDracoCacheMaxSize /*= 0*/)
+{
+    DracoCacheDirectory = InDracoCacheDirectory;
+    DracoCacheMaxSize = FMath::Max<int64>(InDracoCacheMaxSize, 0);
+}
 
-        const std::shared_ptr<libgltf::SAccessor>& Accessor = InGlTF->accessors[(int32)*(InSkin->inverseBindMatrices)];
-        return GetAccessorData<FMatrix, bSwapYZ, bInverseX>(InGlTF, InBuffers, Accessor, OutInverseBindMatrices);
+void FglTFBuffers::TrimDracoCache() const
+{
+    if (DracoCacheDirectory.IsEmpty() || DracoCacheMaxSize <= 0) return;
+
+    IFileManager& FileManager = IFileManager::Get();
+    TArray<FString> FileNames;
+    FileManager.FindFiles(FileNames, *(DracoCacheDirectory / TEXT("*.bin")), true, false);
+
+    struct FCacheFile
+    {
+        FString FilePath;
+        int64 Size;
+        FDateTime LastUse;
+    };
+    TArray<FCacheFile> CacheFiles;
+    int64 CacheSize = 0;
+    for (const FString& FileName : FileNames)
+    {
+        FCacheFile CacheFile;
+        CacheFile.FilePath = DracoCacheDirectory / FileName;
+        CacheFile.Size = FileManager.FileSize(*CacheFile.FilePath);
+        if (CacheFile.Size <= 0) continue;
+        CacheFile.LastUse = FileManager.GetTimeStamp(*CacheFile.FilePath);
+        CacheSize += CacheFile.Size;
+        CacheFiles.Emplace(CacheFile);
     }
+    if (CacheSize <= DracoCacheMaxSize) return;
 
-    bool GetJointIndices(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive, int32 InIndex, const FglTFBuffers& InBuffers, TArray<FVector4>& OutJointIndices)
+    CacheFiles.Sort([](const FCacheFile& InA, const FCacheFile& InB) { return InA.LastUse < InB.LastUse; });
+    for (const FCacheFile& CacheFile : CacheFiles)
     {
-        if (!InGlTF || !InMeshPrimitive) return false;
-        const libgltf::string_t JointName = GLTF_TCHAR_TO_GLTFSTRING(*FString::Printf(TEXT("JOINTS_%d"), InIndex));
-        if (InMeshPrimitive->attributes.find(JointName) == InMeshPrimitive->attributes.cend()) return true;
+        if (CacheSize <= DracoCacheMaxSize) break;
+        /// another import may be reading it, it is deleted next time
+        if (!FileManager.Delete(*CacheFile.FilePath, false, false, true)) continue;
+        CacheSize -= CacheFile.Size;
+    }
+}
 
-        const std::shared_ptr<libgltf::SAccessor>& Accessor = InGlTF->accessors[(int32)*(InMeshPrimitive->attributes[JointName])];
-        return GetAccessorData<FVector4, false, false>(InGlTF, InBuffers, Accessor, OutJointIndices);
+bool FglTFBuffers::DecodeDracoMesh(const std::shared_ptr<libgltf::SGlTF>& InglTF, const libgltf::SKHR_draco_mesh_compressionextension* InExtensionDraco, bool bSwapYZ, FglTFDracoMeshData& OutDracoMeshData) const
+{
+    OutDracoMeshData = FglTFDracoMeshData();
+    OutDracoMeshData.bSwapYZ = bSwapYZ;
+    if (!InglTF || !InExtensionDraco || !InExtensionDraco->bufferView) return false;
+
+    const int32 BufferViewIndex = *(InExtensionDraco->bufferView);
+    if (BufferViewIndex < 0 || BufferViewIndex >= static_cast<int32>(InglTF->bufferViews.size()) || !InglTF->bufferViews[BufferViewIndex]) return false;
+
+    /// decode from the buffer directly, the view counts the bytes in `int32`
+    const int64 EncodedSize = ToByteSize(InglTF->bufferViews[BufferViewIndex]->byteLength);
+    if (EncodedSize > MAX_int32) return false;
+    TglTFAccessorView<uint8> EncodedView;
+    FString BufferFilePath;
+    if (!GetAccessorView(InglTF, BufferViewIndex, 0, static_cast<int32>(EncodedSize), EncodedView, BufferFilePath)) return false;
+
+    FString CacheFilePath;
+    if (!DracoCacheDirectory.IsEmpty())
+    {
+        CacheFilePath = DracoCacheDirectory / glTFImporter::GetDracoMeshDataCacheKey(InExtensionDraco, EncodedView, bSwapYZ) + TEXT(".bin");
+        if (glTFImporter::LoadDracoMeshData(CacheFilePath, OutDracoMeshData)) return true;
+        OutDracoMeshData = FglTFDracoMeshData();
+        OutDracoMeshData.bSwapYZ = bSwapYZ;
     }
 
-    bool GetJointWeights(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive, int32 InIndex, const FglTFBuffers& InBuffers, TArray<FVector4>& OutJointWeights)
+    TArray<FVector4> VertexTangents;
+    const bool bDecoded = bSwapYZ
+        ? FglTFBufferDecoder::Decode<MAX_TEXCOORDS, GLTF_JOINT_LAYERS_NUM_MAX, true, false>(*this, InExtensionDraco, EncodedView.GetData(), EncodedView.Num(),
+            OutDracoMeshData.TriangleIndices, OutDracoMeshData.VertexPositions, OutDracoMeshData.VertexNormals, VertexTangents,
+            OutDracoMeshData.VertexTexcoords, OutDracoMeshData.JointsIndices, OutDracoMeshData.JointWeights)
+        : FglTFBufferDecoder::Decode<MAX_TEXCOORDS, GLTF_JOINT_LAYERS_NUM_MAX, false, true>(*this, InExtensionDraco, EncodedView.GetData(), EncodedView.Num(),
+            OutDracoMeshData.TriangleIndices, OutDracoMeshData.VertexPositions, OutDracoMeshData.VertexNormals, VertexTangents,
+            OutDracoMeshData.VertexTexcoords, OutDracoMeshData.JointsIndices, OutDracoMeshData.JointWeights);
+    if (!bDecoded) return false;
+
+    if (!CacheFilePath.IsEmpty() && !glTFImporter::SaveDracoMeshData(CacheFilePath, OutDracoMeshData))
     {
-        if (!InGlTF || !InMeshPrimitive) return false;
-        const libgltf::string_t JointName = GLTF_TCHAR_TO_GLTFSTRING(*FString::Printf(TEXT("WEIGHTS_%d"), InIndex));
-        if (InMeshPrimitive->attributes.find(JointName) == InMeshPrimitive->attributes.cend()) return true;
+        UE_LOG(LogglTFForUE4, Warning, TEXT("Failed to cache the draco mesh data - %s"), *CacheFilePath);
+    }
+    return true;
+}
 
-        const std::shared_ptr<libgltf::SAccessor>& Accessor = InGlTF->accessors[(int32)*(InMeshPrimitive->attributes[JointName])];
-        return GetAccessorData<FVector4, false, false>(InGlTF, InBuffers, Accessor, OutJointWeights);
+bool FglTFBuffers::FindDracoMeshData(const libgltf::SMeshPrimitive* InMeshPrimitive, bool bSwapYZ, FglTFDracoMeshData& OutDracoMeshData) const
+{
+    TSharedPtr<FglTFDracoMeshData, ESPMode::ThreadSafe> DracoMeshData;
+    {
+        FScopeLock DracoMeshDatasScopeLock(&DracoMeshDatasLock);
+        if (!DracoMeshDatas.RemoveAndCopyValue(InMeshPrimitive, DracoMeshData)) return false;
     }
+    if (!DracoMeshData.IsValid() || DracoMeshData->bSwapYZ != bSwapYZ) return false;
+    OutDracoMeshData = MoveTemp(*DracoMeshData);
+    return true;
+}
 
-    template<int32 TexCoordNumber, int32 JointNumber, bool bSwapYZ, bool bInverseX>
-    bool GetMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
-        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
-        const FglTFBuffers& InBuffers,
-        TArray<uint32>& OutTriangleIndices,
-        TArray<FVector>& OutVertexPositions,
-        TArray<TArray<FVector>>& OutMorphTargetsVertexPositions,
-        TArray<FVector>& OutVertexNormals,
-        TArray<TArray<FVector>>& OutMorphTargetsVertexNormals,
-        TArray<FVector4>& OutVertexTangents,
-        TArray<TArray<FVector4>>& OutMorphTargetsVertexTangents,
-        TArray<FVector2D> OutVertexTexcoords[TexCoordNumber],
-        TArray<FVector4> OutJointsIndices[JointNumber + 1],
-        TArray<FVector4> OutJointWeights[JointNumber + 1])
+namespace glTFImporter
+{
+    template<typename TElem>
+    void SparseArraysToDense(TArray<TSharedPtr<const TglTFSparseArray<TElem>, ESPMode::ThreadSafe>>& InOutSparseArrays, TArray<TArray<TElem>>& OutArrays)
     {
-        /// clean up
-        OutTriangleIndices.Empty();
-        OutVertexPositions.Empty();
-        OutMorphTargetsVertexPositions.Empty();
-        OutVertexNormals.Empty();
-        OutMorphTargetsVertexNormals.Empty();
-        OutVertexTangents.Empty();
-        OutMorphTargetsVertexTangents.Empty();
-        for (uint32 i = 0; i < TexCoordNumber; ++i)
-        {
-            OutVertexTexcoords[i].Empty();
-        }
-        for (uint32 i = 0; i < JointNumber; ++i)
+        OutArrays.SetNum(InOutSparseArrays.Num());
+        for (int32 i = 0; i < InOutSparseArrays.Num(); ++i)
         {
-            OutJointsIndices[i].Empty();
-            OutJointWeights[i].Empty();
+            if (InOutSparseArrays[i].IsValid())
+            {
+                InOutSparseArrays[i]->ToDense(OutArrays[i]);
+            }
+            else
+            {
+                OutArrays[i].Empty();
+            }
         }
+        InOutSparseArrays.Empty();
+    }
 
-        if (!InGlTF || !InMeshPrimitive) return false;
-
-        const libgltf::SKHR_draco_mesh_compressionextension* ExtensionDraco = nullptr;
+    template<typename TElem>
+    void SparseArraysToOwned(TArray<TSharedPtr<const TglTFSparseArray<TElem>, ESPMode::ThreadSafe>>& InOutSparseArrays, TArray<TglTFSparseArray<TElem>>& OutArrays)
+    {
+        OutArrays.SetNum(InOutSparseArrays.Num());
+        for (int32 i = 0; i < InOutSparseArrays.Num(); ++i)
         {
-            const std::shared_ptr<libgltf::SExtension>& Extensions = InMeshPrimitive->extensions;
-            const libgltf::string_t extension_property = GLTF_TCHAR_TO_GLTFSTRING(TEXT("KHR_draco_mesh_compression"));
-            if (!!Extensions && (Extensions->properties.find(extension_property) != Extensions->properties.end()))
-            {
-                ExtensionDraco = (const libgltf::SKHR_draco_mesh_compressionextension*)Extensions->properties[extension_property].get();
-            }
+            FglTFMeshData::MoveOrCopy(InOutSparseArrays[i], OutArrays[i]);
         }
+        InOutSparseArrays.Empty();
+    }
 
-        if (ExtensionDraco)
+    /// for the callers that own and change the arrays, they are moved out if not shared
+    template<int32 TexCoordNumber, int32 JointNumber>
+    void MeshDataToOwned(FglTFMeshData& InOutMeshData,
+        TArray<uint32>& OutTriangleIndices,
+        TArray<FVector>& OutVertexPositions,
+        TArray<FVector>& OutVertexNormals,
+        TArray<FVector4>& OutVertexTangents,
+        TArray<FVector2D>* OutVertexTexcoords,
+        TArray<FVector4>* OutJointsIndices,
+        TArray<FVector4>* OutJointsWeights)
+    {
+        FglTFMeshData::MoveOrCopy(InOutMeshData.TriangleIndices, OutTriangleIndices);
+        FglTFMeshData::MoveOrCopy(InOutMeshData.VertexPositions, OutVertexPositions);
+        FglTFMeshData::MoveOrCopy(InOutMeshData.VertexNormals, OutVertexNormals);
+        FglTFMeshData::MoveOrCopy(InOutMeshData.VertexTangents, OutVertexTangents);
+        for (int32 i = 0; i < TexCoordNumber; ++i)
         {
-            int32 BufferViewIndex = *(ExtensionDraco->bufferView);
-            TArray<uint8> EncodeBuffer;
-            FString BufferFilePath;
-            if (!InBuffers.GetBufferViewData<>(InGlTF, BufferViewIndex, EncodeBuffer, BufferFilePath)
-                || !FglTFBufferDecoder::Decode<TexCoordNumber, JointNumber, bSwapYZ, bInverseX>(InBuffers, ExtensionDraco, EncodeBuffer, OutTriangleIndices, OutVertexPositions, OutVertexNormals, OutVertexTangents, OutVertexTexcoords, OutJointsIndices, OutJointWeights))
-            {
-                return false;
-            }
+            FglTFMeshData::MoveOrCopy(InOutMeshData.VertexTexcoords[i], OutVertexTexcoords[i]);
         }
-        else
+        for (int32 i = 0; i < JointNumber; ++i)
         {
-            if (!GetTriangleIndices<bSwapYZ>(InGlTF, InMeshPrimitive, InBuffers, OutTriangleIndices))
-            {
-                return false;
-            }
-
-            if (!GetVertexPositions<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, OutVertexPositions))
-            {
-                return false;
-            }
-
-            if (!GetVertexNormals<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, OutVertexNormals))
-            {
-                return false;
-            }
-
-            if (!GetVertexTangents<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, OutVertexTangents))
-            {
-                return false;
-            }
-
-            /// only `POSITION`, `NORMAL`, and `TANGENT` supported for morph target
-            for (int32 i = 0, ic = static_cast<int32>(InMeshPrimitive->targets.size()); i < ic; ++i)
-            {
-                TArray<FVector> VertexPositions;
-                GetVertexPositions<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, VertexPositions, i);
-                OutMorphTargetsVertexPositions.Add(VertexPositions);
-
-                TArray<FVector> VertexNormals;
-                GetVertexNormals<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, VertexNormals, i);
-                OutMorphTargetsVertexNormals.Add(VertexNormals);
-
-                TArray<FVector4> VertexTangents;
-                GetVertexTangents<bSwapYZ, bInverseX>(InGlTF, InMeshPrimitive, InBuffers, VertexTangents, i);
-                OutMorphTargetsVertexTangents.Add(VertexTangents);
-            }
-
-            if (!GetVertexTexcoords<TexCoordNumber>(InGlTF, InMeshPrimitive, InBuffers, OutVertexTexcoords))
-            {
-                return false;
-            }
-
-            for (int32 i = 0; i < JointNumber; ++i)
-            {
-                GetJointIndices(InGlTF, InMeshPrimitive, i, InBuffers, OutJointsIndices[i]);
-            }
-
-            for (int32 i = 0; i < JointNumber; ++i)
-            {
-                GetJointWeights(InGlTF, InMeshPrimitive, i, InBuffers, OutJointWeights[i]);
-            }
+            FglTFMeshData::MoveOrCopy(InOutMeshData.JointsIndices[i], OutJointsIndices[i]);
+            FglTFMeshData::MoveOrCopy(InOutMeshData.JointsWeights[i], OutJointsWeights[i]);
         }
-        return true;
     }
 }
 
@@ -1566,23 +3390,59 @@ bool FglTFImporter::GetStaticMeshData(const std::shared_ptr<libgltf::SGlTF>& InG
     TArray<FVector2D> OutVertexTexcoords[MAX_TEXCOORDS],
     bool bSwapYZ /*= true*/)
 {
-    TArray<FVector4> JointsIndices[1];
-    TArray<FVector4> JointsWeights[1];
+    FglTFMeshData MeshData;
+    if (!GetStaticMeshData(InGlTF, InMeshPrimitive, InBuffers, MeshData, bSwapYZ)) return false;
+
+    glTFImporter::MeshDataToOwned<MAX_TEXCOORDS, 0>(MeshData, OutTriangleIndices, OutVertexPositions, OutVertexNormals, OutVertexTangents, OutVertexTexcoords, nullptr, nullptr);
+    glTFImporter::SparseArraysToDense(MeshData.MorphTargetsVertexPositions, OutMorphTargetsVertexPositions);
+    glTFImporter::SparseArraysToDense(MeshData.MorphTargetsVertexNormals, OutMorphTargetsVertexNormals);
+    glTFImporter::SparseArraysToDense(MeshData.MorphTargetsVertexTangents, OutMorphTargetsVertexTangents);
+    return true;
+}
+
+bool FglTFImporter::GetStaticMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+    const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+    const FglTFBuffers& InBuffers,
+    TArray<uint32>& OutTriangleIndices,
+    TArray<FVector>& OutVertexPositions,
+    TArray<TglTFSparseArray<FVector>>& OutMorphTargetsVertexPositions,
+    TArray<FVector>& OutVertexNormals,
+    TArray<TglTFSparseArray<FVector>>& OutMorphTargetsVertexNormals,
+    TArray<FVector4>& OutVertexTangents,
+    TArray<TglTFSparseArray<FVector4>>& OutMorphTargetsVertexTangents,
+    TArray<FVector2D> OutVertexTexcoords[MAX_TEXCOORDS],
+    bool bSwapYZ /*= true*/)
+{
+    FglTFMeshData MeshData;
+    if (!GetStaticMeshData(InGlTF, InMeshPrimitive, InBuffers, MeshData, bSwapYZ)) return false;
+
+    glTFImporter::MeshDataToOwned<MAX_TEXCOORDS, 0>(MeshData, OutTriangleIndices, OutVertexPositions, OutVertexNormals, OutVertexTangents, OutVertexTexcoords, nullptr, nullptr);
+    glTFImporter::SparseArraysToOwned(MeshData.MorphTargetsVertexPositions, OutMorphTargetsVertexPositions);
+    glTFImporter::SparseArraysToOwned(MeshData.MorphTargetsVertexNormals, OutMorphTargetsVertexNormals);
+    glTFImporter::SparseArraysToOwned(MeshData.MorphTargetsVertexTangents, OutMorphTargetsVertexTangents);
+    return true;
+}
+
+bool FglTFImporter::GetStaticMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+    const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+    const FglTFBuffers& InBuffers,
+    FglTFMeshData& OutMeshData,
+    bool bSwapYZ /*= true*/)
+{
+    return bSwapYZ
+        ? glTFImporter::GetMeshData<MAX_TEXCOORDS, 0, true, false>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData)
+        : glTFImporter::GetMeshData<MAX_TEXCOORDS, 0, false, true>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData);
+}
+
+bool FglTFImporter::GetSkeletalMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+    const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+    const FglTFBuffers& InBuffers,
+    FglTFMeshData& OutMeshData,
+    bool bSwapYZ /*= true*/)
+{
     return bSwapYZ
-        ? glTFImporter::GetMeshData<MAX_TEXCOORDS, 0, true, false>(InGlTF, InMeshPrimitive, InBuffers,
-            OutTriangleIndices,
-            OutVertexPositions, OutMorphTargetsVertexPositions,
-            OutVertexNormals, OutMorphTargetsVertexNormals,
-            OutVertexTangents, OutMorphTargetsVertexTangents,
-            OutVertexTexcoords,
-            JointsIndices, JointsWeights)
-        : glTFImporter::GetMeshData<MAX_TEXCOORDS, 0, false, true>(InGlTF, InMeshPrimitive, InBuffers,
-            OutTriangleIndices,
-            OutVertexPositions, OutMorphTargetsVertexPositions,
-            OutVertexNormals, OutMorphTargetsVertexNormals,
-            OutVertexTangents, OutMorphTargetsVertexTangents,
-            OutVertexTexcoords,
-            JointsIndices, JointsWeights);
+        ? glTFImporter::GetMeshData<MAX_TEXCOORDS, GLTF_JOINT_LAYERS_NUM_MAX, true, false>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData)
+        : glTFImporter::GetMeshData<MAX_TEXCOORDS, GLTF_JOINT_LAYERS_NUM_MAX, false, true>(InGlTF, InMeshPrimitive, InBuffers, OutMeshData);
 }
 
 bool FglTFImporter::GetSkeletalMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
@@ -1600,21 +3460,15 @@ bool FglTFImporter::GetSkeletalMeshData(const std::shared_ptr<libgltf::SGlTF>& I
     TArray<FVector4> OutJointsWeights[GLTF_JOINT_LAYERS_NUM_MAX],
     bool bSwapYZ /*= true*/)
 {
-    return bSwapYZ
-        ? glTFImporter::GetMeshData<MAX_TEXCOORDS, GLTF_JOINT_LAYERS_NUM_MAX, true, false>(InGlTF, InMeshPrimitive, InBuffers,
-            OutTriangleIndices,
-            OutVertexPositions, OutMorphTargetsVertexPositions,
-            OutVertexNormals, OutMorphTargetsVertexNormals,
-            OutVertexTangents, OutMorphTargetsVertexTangents,
-            OutVertexTexcoords,
-            OutJointsIndices, OutJointsWeights)
-        : glTFImporter::GetMeshData<MAX_TEXCOORDS, GLTF_JOINT_LAYERS_NUM_MAX, false, true>(InGlTF, InMeshPrimitive, InBuffers,
-            OutTriangleIndices,
-            OutVertexPositions, OutMorphTargetsVertexPositions,
-            OutVertexNormals, OutMorphTargetsVertexNormals,
-            OutVertexTangents, OutMorphTargetsVertexTangents,
-            OutVertexTexcoords,
-            OutJointsIndices, OutJointsWeights);
+    FglTFMeshData MeshData;
+    if (!GetSkeletalMeshData(InGlTF, InMeshPrimitive, InBuffers, MeshData, bSwapYZ)) return false;
+
+    /// the skeletal mesh import data needs the whole mesh for each morph target
+    glTFImporter::MeshDataToOwned<MAX_TEXCOORDS, GLTF_JOINT_LAYERS_NUM_MAX>(MeshData, OutTriangleIndices, OutVertexPositions, OutVertexNormals, OutVertexTangents, OutVertexTexcoords, OutJointsIndices, OutJointsWeights);
+    glTFImporter::SparseArraysToDense(MeshData.MorphTargetsVertexPositions, OutMorphTargetsVertexPositions);
+    glTFImporter::SparseArraysToDense(MeshData.MorphTargetsVertexNormals, OutMorphTargetsVertexNormals);
+    glTFImporter::SparseArraysToDense(MeshData.MorphTargetsVertexTangents, OutMorphTargetsVertexTangents);
+    return true;
 }
 
 bool FglTFImporter::GetInverseBindMatrices(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SSkin>& InSkin, const FglTFBuffers& InBuffers, TArray<FMatrix>& OutInverseBindMatrices, bool bSwapYZ /*= true*/)
@@ -1655,18 +3509,16 @@ bool FglTFImporter::GetAnimationSequenceData(const std::shared_ptr<libgltf::SGlT
         if (!glTFAnimationSamplerInputAccessorIndexPtr) continue;
         int32 InputAccessorIndex = *glTFAnimationSamplerInputAccessorIndexPtr;
         if (InputAccessorIndex < 0 || InputAccessorIndex >= static_cast<int32>(InGlTF->accessors.size())) continue;
-        const std::shared_ptr<libgltf::SAccessor>& glTFInputAccessorPtr = InGlTF->accessors[InputAccessorIndex];
-        if (!glTFInputAccessorPtr) continue;
 
         const std::shared_ptr<libgltf::SGlTFId>& glTFAnimationSamplerOutputAccessorIndexPtr = glTFAnimationSamplerPtr->output;
         if (!glTFAnimationSamplerOutputAccessorIndexPtr) continue;
         int32 OutputAccessorIndex = *glTFAnimationSamplerOutputAccessorIndexPtr;
         if (OutputAccessorIndex < 0 || OutputAccessorIndex >= static_cast<int32>(InGlTF->accessors.size())) continue;
-        const std::shared_ptr<libgltf::SAccessor>& glTFOutputAccessorPtr = InGlTF->accessors[OutputAccessorIndex];
-        if (!glTFOutputAccessorPtr) continue;
 
-        TArray<float> Times;
-        if (!glTFImporter::GetAccessorData<float, false, false>(InGlTF, InBuffers, glTFInputAccessorPtr, Times)) continue;
+        /// the samplers of an animation usually share the input, it is read in place
+        TSharedPtr<const TArray<float>, ESPMode::ThreadSafe> SharedTimes;
+        if (!glTFImporter::GetSharedAccessorData<float, false, false>(InGlTF, InBuffers, InputAccessorIndex, SharedTimes)) continue;
+        const TArray<float>& Times = *SharedTimes;
 
         const FString glTFAnimationSamplerInterpolation = GLTF_GLTFSTRING_TO_TCHAR(glTFAnimationSamplerPtr->interpolation.c_str());
         ERichCurveInterpMode Interpolation = StringToRichCurveInterpMode(glTFAnimationSamplerInterpolation);
@@ -1680,38 +3532,38 @@ bool FglTFImporter::GetAnimationSequenceData(const std::shared_ptr<libgltf::SGlT
         {
             if (bSwapYZ)
             {
-                if (!glTFImporter::GetAccessorData<FVector, true, false>(InGlTF, InBuffers, glTFOutputAccessorPtr, Translations)) continue;
+                if (!glTFImporter::GetAccessorData<FVector, true, false>(InGlTF, InBuffers, OutputAccessorIndex, Translations)) continue;
             }
             else
             {
-                if (!glTFImporter::GetAccessorData<FVector, false, false>(InGlTF, InBuffers, glTFOutputAccessorPtr, Translations)) continue;
+                if (!glTFImporter::GetAccessorData<FVector, false, false>(InGlTF, InBuffers, OutputAccessorIndex, Translations)) continue;
             }
         }
         else if (glTFAnimationChannelTargetPath.Equals(TEXT("rotation"), ESearchCase::IgnoreCase))
         {
             if (bSwapYZ)
             {
-                if (!glTFImporter::GetAccessorData<FQuat, true, false>(InGlTF, InBuffers, glTFOutputAccessorPtr, Rotations)) continue;
+                if (!glTFImporter::GetAccessorData<FQuat, true, false>(InGlTF, InBuffers, OutputAccessorIndex, Rotations)) continue;
             }
             else
             {
-                if (!glTFImporter::GetAccessorData<FQuat, false, false>(InGlTF, InBuffers, glTFOutputAccessorPtr, Rotations)) continue;
+                if (!glTFImporter::GetAccessorData<FQuat, false, false>(InGlTF, InBuffers, OutputAccessorIndex, Rotations)) continue;
             }
         }
         else if (glTFAnimationChannelTargetPath.Equals(TEXT("scale"), ESearchCase::IgnoreCase))
         {
             if (bSwapYZ)
             {
-                if (!glTFImporter::GetAccessorData<FVector, true, false>(InGlTF, InBuffers, glTFOutputAccessorPtr, Scales)) continue;
+                if (!glTFImporter::GetAccessorData<FVector, true, false>(InGlTF, InBuffers, OutputAccessorIndex, Scales)) continue;
             }
             else
             {
-                if (!glTFImporter::GetAccessorData<FVector, false, false>(InGlTF, InBuffers, glTFOutputAccessorPtr, Scales)) continue;
+                if (!glTFImporter::GetAccessorData<FVector, false, false>(InGlTF, InBuffers, OutputAccessorIndex, Scales)) continue;
             }
         }
         else if (glTFAnimationChannelTargetPath.Equals(TEXT("weights"), ESearchCase::IgnoreCase))
         {
-            if (!glTFImporter::GetAccessorData<float, true, false>(InGlTF, InBuffers, glTFOutputAccessorPtr, Weights)) continue;
+            if (!glTFImporter::GetAccessorData<float, true, false>(InGlTF, InBuffers, OutputAccessorIndex, Weights)) continue;
         }
 
         if (Translations.Num() == Times.Num())
@@ -1856,40 +3708,44 @@ bool FglTFImporter::GetNodeParentIndicesAndTransforms(const std::shared_ptr<libg
 
     OutAbsoluteTransforms = OutRelativeTransforms;
 
-    TArray<int32> VisitedIndices;
-    TArray<int32> ParentIndices;
-    do
+    /// resolve the unresolved ancestors of each node from the top, so every node is visited once
+    enum EResolveState : uint8
     {
-        TArray<int32> ChildIndices;
-
-        for (int32 i = 0; i < OutParentIndices.Num(); ++i)
+        ResolveState_Unresolved,
+        ResolveState_Resolving,
+        ResolveState_Resolved,
+    };
+    TArray<uint8> ResolveStates;
+    ResolveStates.Init(ResolveState_Unresolved, OutParentIndices.Num());
+    TArray<int32> NodeChain;
+    for (int32 i = 0; i < OutParentIndices.Num(); ++i)
+    {
+        int32 NodeIndex = i;
+        while (NodeIndex != INDEX_NONE && ResolveStates[NodeIndex] == ResolveState_Unresolved)
         {
-            int32 ParentIndex = OutParentIndices[i];
-            if (ParentIndices.Num() <= 0)
-            {
-                if (ParentIndex == INDEX_NONE)
-                {
-                    ChildIndices.Emplace(i);
-                }
-            }
-            else if (ParentIndices.Contains(ParentIndex))
-            {
-                ChildIndices.Emplace(i);
-            }
+            ResolveStates[NodeIndex] = ResolveState_Resolving;
+            NodeChain.Push(NodeIndex);
+            NodeIndex = OutParentIndices[NodeIndex];
         }
 
-        for (int32 NextTargetIndex : ChildIndices)
+        /// the nodes in the chain are resolved before the next one, so it is a cycle if the chain reaches itself
+        if (NodeIndex != INDEX_NONE && ResolveStates[NodeIndex] == ResolveState_Resolving)
         {
-            check(NextTargetIndex != INDEX_NONE);
-            if (OutParentIndices[NextTargetIndex] == INDEX_NONE) continue;
-            OutAbsoluteTransforms[NextTargetIndex] = OutRelativeTransforms[NextTargetIndex] * OutAbsoluteTransforms[OutParentIndices[NextTargetIndex]];
+            UE_LOG(LogglTFForUE4, Error, TEXT("The node %d is in a cycle of the hierarchy!"), NodeIndex);
+            return false;
         }
 
-        VisitedIndices.Append(ChildIndices);
-
-        ParentIndices = ChildIndices;
-
-    } while (ParentIndices.Num() > 0 && VisitedIndices.Num() < OutParentIndices.Num());
+        while (NodeChain.Num() > 0)
+        {
+            const int32 ChildIndex = NodeChain.Pop(false);
+            const int32 ParentIndex = OutParentIndices[ChildIndex];
+            if (ParentIndex != INDEX_NONE)
+            {
+                OutAbsoluteTransforms[ChildIndex] = OutRelativeTransforms[ChildIndex] * OutAbsoluteTransforms[ParentIndex];
+            }
+            ResolveStates[ChildIndex] = ResolveState_Resolved;
+        }
+    }
     return true;
 }
 
@@ -1913,6 +3769,60 @@ bool FglTFImporter::GetNodeInfos(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
     return true;
 }
 
+bool FglTFImporter::GetNodeInstanceTransforms(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SNode>& InNode, const FglTFBuffers& InBuffers, TArray<FTransform>& OutInstanceTransforms, bool bSwapYZ /*= true*/)
+{
+    OutInstanceTransforms.Empty();
+    if (!InGlTF || !InNode || !InNode->extensions) return false;
+
+    const libgltf::string_t extension_property = GLTF_TCHAR_TO_GLTFSTRING(TEXT("EXT_mesh_gpu_instancing"));
+    std::map<libgltf::string_t, std::shared_ptr<libgltf::SObject>>::const_iterator ExtensionIt = InNode->extensions->properties.find(extension_property);
+    if (ExtensionIt == InNode->extensions->properties.cend() || !ExtensionIt->second) return false;
+    const libgltf::SEXT_mesh_gpu_instancingglTFextension* ExtensionInstancing = (const libgltf::SEXT_mesh_gpu_instancingglTFextension*)ExtensionIt->second.get();
+
+    auto GetAttributeAccessorIndex = [ExtensionInstancing](const TCHAR* InAttributeName) -> int32
+    {
+        const libgltf::string_t attribute_key = GLTF_TCHAR_TO_GLTFSTRING(InAttributeName);
+        std::map<libgltf::string_t, std::shared_ptr<libgltf::SGlTFId>>::const_iterator AttributeIt = ExtensionInstancing->attributes.find(attribute_key);
+        if (AttributeIt == ExtensionInstancing->attributes.cend() || !AttributeIt->second) return INDEX_NONE;
+        return *(AttributeIt->second);
+    };
+
+    /// read the attributes in bulk, they are converted to the unreal space with the whole transform
+    TArray<FVector> Translations;
+    TArray<FQuat> Rotations;
+    TArray<FVector> Scales;
+    const int32 TranslationAccessorIndex = GetAttributeAccessorIndex(TEXT("TRANSLATION"));
+    const int32 RotationAccessorIndex = GetAttributeAccessorIndex(TEXT("ROTATION"));
+    const int32 ScaleAccessorIndex = GetAttributeAccessorIndex(TEXT("SCALE"));
+    if (TranslationAccessorIndex != INDEX_NONE && !glTFImporter::GetAccessorData<FVector, false, false>(InGlTF, InBuffers, TranslationAccessorIndex, Translations)) return false;
+    if (RotationAccessorIndex != INDEX_NONE && !glTFImporter::GetAccessorData<FQuat, false, false>(InGlTF, InBuffers, RotationAccessorIndex, Rotations)) return false;
+    if (ScaleAccessorIndex != INDEX_NONE && !glTFImporter::GetAccessorData<FVector, false, false>(InGlTF, InBuffers, ScaleAccessorIndex, Scales)) return false;
+
+    /// all attributes have the same count
+    const int32 InstanceCount = FMath::Max3(Translations.Num(), Rotations.Num(), Scales.Num());
+    if (InstanceCount <= 0) return false;
+    if ((Translations.Num() > 0 && Translations.Num() != InstanceCount)
+        || (Rotations.Num() > 0 && Rotations.Num() != InstanceCount)
+        || (Scales.Num() > 0 && Scales.Num() != InstanceCount))
+    {
+        UE_LOG(LogglTFForUE4, Error, TEXT("The counts of the instance attributes are different!"));
+        return false;
+    }
+
+    const FTransform Convert(FglTFImporter::GetglTFSpaceToUnrealSpace(bSwapYZ, !bSwapYZ));
+    OutInstanceTransforms.SetNumUninitialized(InstanceCount);
+    ParallelFor(InstanceCount, [&](int32 InInstanceIndex)
+    {
+        FTransform& InstanceTransform = OutInstanceTransforms[InInstanceIndex];
+        InstanceTransform = FTransform(
+            Rotations.Num() > 0 ? Rotations[InInstanceIndex] : FQuat::Identity,
+            Translations.Num() > 0 ? Translations[InInstanceIndex] : FVector::ZeroVector,
+            Scales.Num() > 0 ? Scales[InInstanceIndex] : FVector(1.0f));
+        InstanceTransform = Convert * InstanceTransform * Convert;
+    }, InstanceCount < GglTFParallelDecodeVerticesMin);
+    return true;
+}
+
 FString FglTFImporter::SanitizeObjectName(const FString& InObjectName)
 {
     FString SanitizedName;
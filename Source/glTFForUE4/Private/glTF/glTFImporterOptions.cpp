@@ -24,9 +24,17 @@ FglTFImporterOptionsDetailsStored::FglTFImporterOptionsDetailsStored()
     , bRemoveDegenerates(false)
     , bBuildAdjacencyBuffer(false)
     , bUseFullPrecisionUVs(false)
+#if ENGINE_MINOR_VERSION <= 23
+    , bUseMeshDescription(false)
+#else
+    , bUseMeshDescription(true)
+#endif
     , bImportAnimation(true)
     , bImportMorphTarget(true)
     , bCreatePhysicsAsset(true)
+    , bMergeStaticMeshes(false)
+    , MergeStaticMeshesRootNode(INDEX_NONE)
+    , MaxTrianglesPerMergedMesh(1000000)
     , bUseMaterialInstance(true)
 {
     //
@@ -50,13 +58,27 @@ UglTFImporterOptionsDetails::UglTFImporterOptionsDetails(const FObjectInitialize
     , bRemoveDegenerates(false)
     , bBuildAdjacencyBuffer(false)
     , bUseFullPrecisionUVs(false)
+#if ENGINE_MINOR_VERSION <= 23
+    , bUseMeshDescription(false)
+#else
+    , bUseMeshDescription(true)
+#endif
     , bImportAnimation(true)
     , bImportMorphTarget(true)
     , bCreatePhysicsAsset(true)
+    , bMergeStaticMeshes(false)
+    , MergeStaticMeshesRootNode(INDEX_NONE)
+    , MaxTrianglesPerMergedMesh(1000000)
     , bUseMaterialInstance(true)
     , bImportLightInLevel(false)
     , bImportCameraInLevel(false)
     , ImportLevelTemplate()
+    , bInstanceRepeatedMeshes(false)
+    , bSpawnActorsInBatch(false)
+    , bPartitionLevelInGrid(false)
+    , LevelGridCellSize(51200.0f)
+    , bLevelGridIn3D(false)
+    , LevelGridStreamingDistance(25600.0f)
 {
     //
 }
@@ -78,9 +100,13 @@ void UglTFImporterOptionsDetails::Get(FglTFImporterOptionsDetailsStored& OutDeta
     OutDetailsStored.bRemoveDegenerates = bRemoveDegenerates;
     OutDetailsStored.bBuildAdjacencyBuffer = bBuildAdjacencyBuffer;
     OutDetailsStored.bUseFullPrecisionUVs = bUseFullPrecisionUVs;
+    OutDetailsStored.bUseMeshDescription = bUseMeshDescription;
     OutDetailsStored.bImportAnimation = bImportAnimation;
     OutDetailsStored.bImportMorphTarget = bImportMorphTarget;
     OutDetailsStored.bCreatePhysicsAsset = bCreatePhysicsAsset;
+    OutDetailsStored.bMergeStaticMeshes = bMergeStaticMeshes;
+    OutDetailsStored.MergeStaticMeshesRootNode = MergeStaticMeshesRootNode;
+    OutDetailsStored.MaxTrianglesPerMergedMesh = MaxTrianglesPerMergedMesh;
     OutDetailsStored.bUseMaterialInstance = bUseMaterialInstance;
 }
 
@@ -101,9 +127,13 @@ void UglTFImporterOptionsDetails::Set(const FglTFImporterOptionsDetailsStored& I
     bRemoveDegenerates = InDetailsStored.bRemoveDegenerates;
     bBuildAdjacencyBuffer = InDetailsStored.bBuildAdjacencyBuffer;
     bUseFullPrecisionUVs = InDetailsStored.bUseFullPrecisionUVs;
+    bUseMeshDescription = InDetailsStored.bUseMeshDescription;
     bImportAnimation = InDetailsStored.bImportAnimation;
     bImportMorphTarget = InDetailsStored.bImportMorphTarget;
     bCreatePhysicsAsset = InDetailsStored.bCreatePhysicsAsset;
+    bMergeStaticMeshes = InDetailsStored.bMergeStaticMeshes;
+    MergeStaticMeshesRootNode = InDetailsStored.MergeStaticMeshesRootNode;
+    MaxTrianglesPerMergedMesh = InDetailsStored.MaxTrianglesPerMergedMesh;
     bUseMaterialInstance = InDetailsStored.bUseMaterialInstance;
 }
 
@@ -5,6 +5,11 @@
 
 UglTFForUE4Settings::UglTFForUE4Settings(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
+    , bLazyLoadBuffers(true)
+    , LazyLoadBuffersBudgetInMB(1024)
+    , bPrefetchBuffers(false)
+    , bCacheDracoMeshes(false)
+    , DracoMeshesCacheSizeInMB(512)
 {
     //
 }
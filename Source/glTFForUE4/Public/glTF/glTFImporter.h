@@ -74,6 +74,24 @@ struct GLTFFORUE4_API FglTFImporterNodeInfo
     static const FglTFImporterNodeInfo Default;
 };
 
+/// an actor is spawned by `FglTFImporter::SpawnActors` later
+struct GLTFFORUE4_API FglTFImporterSpawnRequest
+{
+    FglTFImporterSpawnRequest();
+
+    /// the actor is attached to the actor of this request
+    int32 ParentRequestIndex;
+
+    /// in the world space
+    FTransform Transform;
+
+    class UStaticMesh* StaticMesh;
+    class USkeletalMesh* SkeletalMesh;
+
+    /// spawn a hierarchical instanced static mesh component for the static mesh if it isn't empty, relative to the actor
+    TArray<FTransform> InstanceTransforms;
+};
+
 USTRUCT()
 struct GLTFFORUE4_API FglTFImporterCollection
 {
@@ -81,47 +99,448 @@ struct GLTFFORUE4_API FglTFImporterCollection
 
     UPROPERTY()
     class UWorld* TargetWorld;
-    
+
+    /// the node infos are indexed by the node index, all nodes are filled by `FglTFImporter::GetNodeParentIndicesAndTransforms`
     UPROPERTY()
-    TMap<int32, FglTFImporterNodeInfo> NodeInfos;
-    
+    TArray<int32> NodeParentIndices;
+
     UPROPERTY()
-    TMap<int32, class UTexture*> Textures;
-    
+    TArray<FTransform> NodeRelativeTransforms;
+
     UPROPERTY()
-    TMap<int32, class UMaterialInterface*> Materials;
-    
+    TArray<FTransform> NodeAbsoluteTransforms;
+
+    /// the objects are indexed by the glTF index, use `Find*` and `Add*` to access them
     UPROPERTY()
-    TMap<int32, class UStaticMesh*> StaticMeshes;
-    
+    TArray<class UTexture*> Textures;
+
     UPROPERTY()
-    TMap<int32, class USkeletalMesh*> SkeletalMeshes;
+    TArray<class UMaterialInterface*> Materials;
+
+    UPROPERTY()
+    TArray<class UStaticMesh*> StaticMeshes;
+
+    UPROPERTY()
+    TArray<class USkeletalMesh*> SkeletalMeshes;
+
+    /// the transforms of the nodes that instance the static mesh, indexed by the mesh index
+    TArray<TArray<FTransform>> StaticMeshInstanceTransforms;
+
+    /// the meshes are kept by the arrays above
+    TArray<FglTFImporterSpawnRequest> SpawnRequests;
+    /// the request of the node or its nearest ancestor, indexed by the node index
+    TArray<int32> NodeSpawnRequestIndices;
+
+    /// the nodes whose meshes are merged in the merged static meshes, indexed by the node index
+    TBitArray<> NodesMerged;
 
     FglTFImporterCollection();
 
-    const FglTFImporterNodeInfo& FindNodeInfo(int32 InNodeId) const;
+    /// size the arrays by the counts in the glTF, so adding the objects doesn't grow them
+    void Reserve(const std::shared_ptr<libgltf::SGlTF>& InGlTF);
+
+#if ENGINE_MINOR_VERSION <= 21
+    DEPRECATED(4.26, "Use GetNodeParentIndex, GetNodeRelativeTransform and GetNodeAbsoluteTransform instead.")
+#else
+    UE_DEPRECATED(4.26, "Use GetNodeParentIndex, GetNodeRelativeTransform and GetNodeAbsoluteTransform instead.")
+#endif
+    FglTFImporterNodeInfo FindNodeInfo(int32 InNodeId) const;
+
+    bool HasNodeInfo(int32 InNodeId) const { return NodeParentIndices.IsValidIndex(InNodeId); }
+    int32 GetNodeParentIndex(int32 InNodeId) const { return HasNodeInfo(InNodeId) ? NodeParentIndices[InNodeId] : INDEX_NONE; }
+    const FTransform& GetNodeRelativeTransform(int32 InNodeId) const { return HasNodeInfo(InNodeId) ? NodeRelativeTransforms[InNodeId] : FTransform::Identity; }
+    const FTransform& GetNodeAbsoluteTransform(int32 InNodeId) const { return HasNodeInfo(InNodeId) ? NodeAbsoluteTransforms[InNodeId] : FTransform::Identity; }
+
+    /// the found object may be null if it failed to import
+    bool FindTexture(int32 InTextureId, class UTexture*& OutTexture) const { return FindObject(Textures, TexturesAdded, InTextureId, OutTexture); }
+    bool FindMaterial(int32 InMaterialId, class UMaterialInterface*& OutMaterial) const { return FindObject(Materials, MaterialsAdded, InMaterialId, OutMaterial); }
+    bool FindStaticMesh(int32 InMeshId, class UStaticMesh*& OutStaticMesh) const { return FindObject(StaticMeshes, StaticMeshesAdded, InMeshId, OutStaticMesh); }
+    bool FindSkeletalMesh(int32 InMeshId, class USkeletalMesh*& OutSkeletalMesh) const { return FindObject(SkeletalMeshes, SkeletalMeshesAdded, InMeshId, OutSkeletalMesh); }
+
+    void AddTexture(int32 InTextureId, class UTexture* InTexture) { AddObject(Textures, TexturesAdded, InTextureId, InTexture); }
+    void AddMaterial(int32 InMaterialId, class UMaterialInterface* InMaterial) { AddObject(Materials, MaterialsAdded, InMaterialId, InMaterial); }
+    void AddStaticMesh(int32 InMeshId, class UStaticMesh* InStaticMesh) { AddObject(StaticMeshes, StaticMeshesAdded, InMeshId, InStaticMesh); }
+    void AddSkeletalMesh(int32 InMeshId, class USkeletalMesh* InSkeletalMesh) { AddObject(SkeletalMeshes, SkeletalMeshesAdded, InMeshId, InSkeletalMesh); }
+
+    void AddStaticMeshInstance(int32 InMeshId, const FTransform& InTransform)
+    {
+        if (InMeshId < 0) return;
+        if (InMeshId >= StaticMeshInstanceTransforms.Num()) StaticMeshInstanceTransforms.SetNum(InMeshId + 1);
+        StaticMeshInstanceTransforms[InMeshId].Add(InTransform);
+    }
+
+    /// call it before the children of the node are created
+    void InheritSpawnRequest(int32 InNodeId)
+    {
+        if (NodeSpawnRequestIndices.Num() != NodeParentIndices.Num()) NodeSpawnRequestIndices.Init(INDEX_NONE, NodeParentIndices.Num());
+        if (!NodeSpawnRequestIndices.IsValidIndex(InNodeId)) return;
+        const int32 ParentIndex = GetNodeParentIndex(InNodeId);
+        NodeSpawnRequestIndices[InNodeId] = NodeSpawnRequestIndices.IsValidIndex(ParentIndex) ? NodeSpawnRequestIndices[ParentIndex] : INDEX_NONE;
+    }
+
+    /// the request is attached to the request of the nearest ancestor, `INDEX_NONE` means no node
+    int32 AddSpawnRequest(int32 InNodeId, FglTFImporterSpawnRequest InSpawnRequest)
+    {
+        const int32 SpawnRequestIndex = SpawnRequests.Add(MoveTemp(InSpawnRequest));
+        if (NodeSpawnRequestIndices.IsValidIndex(InNodeId))
+        {
+            SpawnRequests[SpawnRequestIndex].ParentRequestIndex = NodeSpawnRequestIndices[InNodeId];
+            NodeSpawnRequestIndices[InNodeId] = SpawnRequestIndex;
+        }
+        return SpawnRequestIndex;
+    }
+
+    void AddStaticMeshInstances(int32 InMeshId, const TArray<FTransform>& InTransforms)
+    {
+        if (InMeshId < 0) return;
+        if (InMeshId >= StaticMeshInstanceTransforms.Num()) StaticMeshInstanceTransforms.SetNum(InMeshId + 1);
+        StaticMeshInstanceTransforms[InMeshId].Append(InTransforms);
+    }
+
+    bool IsNodeMerged(int32 InNodeId) const { return InNodeId >= 0 && InNodeId < NodesMerged.Num() && NodesMerged[InNodeId]; }
+    void SetNodeMerged(int32 InNodeId)
+    {
+        if (InNodeId < 0) return;
+        while (NodesMerged.Num() <= InNodeId) NodesMerged.Add(false);
+        NodesMerged[InNodeId] = true;
+    }
+
+private:
+    template<typename TObject>
+    static bool FindObject(const TArray<TObject*>& InObjects, const TBitArray<>& InObjectsAdded, int32 InIndex, TObject*& OutObject)
+    {
+        if (InIndex < 0 || InIndex >= InObjectsAdded.Num() || !InObjectsAdded[InIndex]) return false;
+        OutObject = InObjects[InIndex];
+        return true;
+    }
+
+    template<typename TObject>
+    static void AddObject(TArray<TObject*>& InOutObjects, TBitArray<>& InOutObjectsAdded, int32 InIndex, TObject* InObject)
+    {
+        if (InIndex < 0) return;
+        if (InIndex >= InOutObjects.Num()) InOutObjects.SetNumZeroed(InIndex + 1);
+        while (InOutObjectsAdded.Num() <= InIndex) InOutObjectsAdded.Add(false);
+        InOutObjects[InIndex] = InObject;
+        InOutObjectsAdded[InIndex] = true;
+    }
+
+    /// mark the added objects, the object is null if the import failed
+    TBitArray<> TexturesAdded;
+    TBitArray<> MaterialsAdded;
+    TBitArray<> StaticMeshesAdded;
+    TBitArray<> SkeletalMeshesAdded;
+};
+
+/// keeps the memory viewed by `FglTFBufferData` alive, the views become invalid once it is released
+struct GLTFFORUE4_API FglTFBufferDataOwner
+{
+    //
 };
 
 class GLTFFORUE4_API FglTFBufferData
 {
 public:
     FglTFBufferData(const TArray<uint8>& InData);
+    FglTFBufferData(const uint8* InData, int64 InSize, const TSharedRef<FglTFBufferDataOwner, ESPMode::ThreadSafe>& InDataOwner);
     FglTFBufferData(const FString& InFileFolderRoot, const FString& InUri);
+    FglTFBufferData(const FString& InFileFolderRoot, const libgltf::string_t& InUri);
+    /// a region of the file, like the BIN chunk of a glb file
+    FglTFBufferData(const FString& InFilePath, int64 InOffset, int64 InSize);
     virtual ~FglTFBufferData();
 
 public:
     operator bool() const;
-    const TArray<uint8>& GetData() const;
+    const uint8* GetData() const;
+    int64 GetSize() const;
     bool IsFromFile() const;
+    bool IsMappedFile() const;
+    bool IsView() const;
     const FString& GetFilePath() const;
 
+private:
+    bool LoadFile(const FString& InFilePath, int64 InOffset = 0, int64 InSize = INDEX_NONE);
+
 private:
     TArray<uint8> Data;
+    /// a non-owning view, like the BIN chunk of a glb file
+    const uint8* ViewData;
+    int64 ViewSize;
+    TWeakPtr<FglTFBufferDataOwner, ESPMode::ThreadSafe> ViewDataOwner;
+#if ENGINE_MINOR_VERSION <= 19
+#else
+    /// a read-only view over the os mapping, the pages are loaded when the accessors read them
+    TUniquePtr<class IMappedFileHandle> MappedFileHandle;
+    TUniquePtr<class IMappedFileRegion> MappedFileRegion;
+#endif
     FString FilePath;
     FString StreamType;
     FString StreamEncoding;
 };
 
+/// a non-owning view of the elements in a buffer view, the element `i` is at `i * Stride` bytes,
+/// it keeps the buffer data alive and converts the elements in one pass without any intermediate array
+template<typename TElem>
+class TglTFAccessorView
+{
+public:
+    TglTFAccessorView()
+        : BufferData()
+        , Data(nullptr)
+        , Stride(0)
+        , Count(0)
+    {
+        //
+    }
+
+    TglTFAccessorView(const TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe>& InBufferData, const uint8* InData, int32 InStride, int32 InCount)
+        : BufferData(InBufferData)
+        , Data(InData)
+        , Stride(InStride)
+        , Count(InCount)
+    {
+        //
+    }
+
+public:
+    bool IsValid() const
+    {
+        return BufferData.IsValid() && Data != nullptr;
+    }
+
+    int32 Num() const
+    {
+        return Count;
+    }
+
+    int32 GetStride() const
+    {
+        return Stride;
+    }
+
+    const uint8* GetData() const
+    {
+        return Data;
+    }
+
+    TElem operator[](int32 InIndex) const
+    {
+        checkSlow(InIndex >= 0 && InIndex < Count);
+        /// the element may be not aligned in the buffer
+        TElem Elem;
+        FMemory::Memcpy(&Elem, Data + static_cast<int64>(InIndex) * Stride, sizeof(TElem));
+        return Elem;
+    }
+
+    template<typename TOutElem>
+    void ConvertTo(TArray<TOutElem>& OutArray) const
+    {
+        OutArray.SetNumUninitialized(Count);
+        TOutElem* OutElems = OutArray.GetData();
+        for (int32 i = 0; i < Count; ++i)
+        {
+            OutElems[i] = (*this)[i];
+        }
+    }
+
+private:
+    TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> BufferData;
+    const uint8* Data;
+    int32 Stride;
+    int32 Count;
+};
+
+/// the elements of a sparse accessor, just the touched elements are stored if `Indices` is not empty,
+/// otherwise `Values` stores all the elements
+template<typename TElem>
+struct TglTFSparseArray
+{
+    TglTFSparseArray()
+        : Count(0)
+        , Indices()
+        , Values()
+    {
+        //
+    }
+
+    int32 Count;
+    TArray<uint32> Indices;
+    TArray<TElem> Values;
+
+    int32 Num() const
+    {
+        return Count;
+    }
+
+    bool IsDense() const
+    {
+        return Indices.Num() <= 0;
+    }
+
+    void Reset()
+    {
+        Count = 0;
+        Indices.Empty();
+        Values.Empty();
+    }
+
+    void ToDense(TArray<TElem>& OutArray) const
+    {
+        if (IsDense())
+        {
+            OutArray = Values;
+            return;
+        }
+        /// the untouched elements have to be zero, not the ones left in the array
+        OutArray.Reset();
+        OutArray.SetNumZeroed(Count);
+        for (int32 i = 0, ic = FMath::Min(Indices.Num(), Values.Num()); i < ic; ++i)
+        {
+            OutArray[Indices[i]] = Values[i];
+        }
+    }
+
+    /// `InOutOrigin[i] += Values[i] * InWeight` for the touched elements
+    void AddTo(TArray<TElem>& InOutOrigin, float InWeight) const
+    {
+        if (InOutOrigin.Num() != Count || InWeight == 0.0f) return;
+        if (IsDense())
+        {
+            for (int32 i = 0, ic = FMath::Min(Count, Values.Num()); i < ic; ++i)
+            {
+                InOutOrigin[i] = InOutOrigin[i] + Values[i] * InWeight;
+            }
+            return;
+        }
+        for (int32 i = 0, ic = FMath::Min(Indices.Num(), Values.Num()); i < ic; ++i)
+        {
+            TElem& Origin = InOutOrigin[Indices[i]];
+            Origin = Origin + Values[i] * InWeight;
+        }
+    }
+};
+
+namespace EglTFAccessorType
+{
+    enum Type
+    {
+        None,
+        Scalar,
+        Vec2,
+        Vec3,
+        Vec4,
+        Mat2,
+        Mat3,
+        Mat4,
+    };
+}
+
+/// an accessor resolved and validated once after the glTF is parsed,
+/// so the readers don't compare the type strings and walk the buffer views again
+struct GLTFFORUE4_API FglTFAccessorDesc
+{
+    FglTFAccessorDesc();
+
+    EglTFAccessorType::Type Type;
+    int32 ComponentType;
+    /// the bytes of one element, like 12 for a `VEC3` of floats
+    int32 ElemSize;
+    /// `INDEX_NONE` if the accessor has no buffer view
+    int32 BufferIndex;
+    /// from the start of the buffer
+    int64 Offset;
+    int32 Stride;
+    int32 Count;
+    bool bNormalized;
+    bool bSparse;
+    bool bValid;
+
+    /// the bytes from the first element to the end of the last element
+    int64 GetByteLength() const
+    {
+        return Count > 0 ? static_cast<int64>(Count - 1) * Stride + ElemSize : 0;
+    }
+
+    static EglTFAccessorType::Type ToAccessorType(const libgltf::string_t& InType);
+    static int32 GetComponentNum(EglTFAccessorType::Type InType);
+    static int32 GetComponentSize(int32 InComponentType);
+};
+
+/// the base of the decoded accessors cached in `FglTFBuffers`
+struct FglTFDecodedAccessor
+{
+    virtual ~FglTFDecodedAccessor() {}
+};
+
+template<typename TDecoded>
+struct TglTFDecodedAccessor : public FglTFDecodedAccessor
+{
+    explicit TglTFDecodedAccessor(const TSharedRef<const TDecoded, ESPMode::ThreadSafe>& InData)
+        : Data(InData)
+    {
+        //
+    }
+
+    const TSharedRef<const TDecoded, ESPMode::ThreadSafe> Data;
+};
+
+/// the attributes of a primitive decoded from `KHR_draco_mesh_compression` ahead of the mesh construction
+struct GLTFFORUE4_API FglTFDracoMeshData
+{
+    FglTFDracoMeshData();
+
+    bool bSwapYZ;
+    TArray<uint32> TriangleIndices;
+    TArray<FVector> VertexPositions;
+    TArray<FVector> VertexNormals;
+    TArray<FVector2D> VertexTexcoords[MAX_TEXCOORDS];
+    TArray<FVector4> JointsIndices[GLTF_JOINT_LAYERS_NUM_MAX + 1];
+    TArray<FVector4> JointWeights[GLTF_JOINT_LAYERS_NUM_MAX + 1];
+};
+
+/// the decoded attributes of a primitive, the arrays are shared with the other primitives or meshes that read the same accessors,
+/// a missing attribute is null, copy the array before changing it
+struct GLTFFORUE4_API FglTFMeshData
+{
+    TSharedPtr<const TArray<uint32>, ESPMode::ThreadSafe> TriangleIndices;
+    TSharedPtr<const TArray<FVector>, ESPMode::ThreadSafe> VertexPositions;
+    TArray<TSharedPtr<const TglTFSparseArray<FVector>, ESPMode::ThreadSafe>> MorphTargetsVertexPositions;
+    TSharedPtr<const TArray<FVector>, ESPMode::ThreadSafe> VertexNormals;
+    TArray<TSharedPtr<const TglTFSparseArray<FVector>, ESPMode::ThreadSafe>> MorphTargetsVertexNormals;
+    TSharedPtr<const TArray<FVector4>, ESPMode::ThreadSafe> VertexTangents;
+    TArray<TSharedPtr<const TglTFSparseArray<FVector4>, ESPMode::ThreadSafe>> MorphTargetsVertexTangents;
+    TSharedPtr<const TArray<FVector2D>, ESPMode::ThreadSafe> VertexTexcoords[MAX_TEXCOORDS];
+    TSharedPtr<const TArray<FVector4>, ESPMode::ThreadSafe> JointsIndices[GLTF_JOINT_LAYERS_NUM_MAX];
+    TSharedPtr<const TArray<FVector4>, ESPMode::ThreadSafe> JointsWeights[GLTF_JOINT_LAYERS_NUM_MAX];
+
+    /// the empty array for a missing attribute
+    template<typename TData>
+    static const TData& Get(const TSharedPtr<const TData, ESPMode::ThreadSafe>& InData)
+    {
+        static const TData Empty;
+        return InData.IsValid() ? *InData : Empty;
+    }
+
+    /// move the array out if nothing else shares it, otherwise copy it, the shared one is released
+    template<typename TData>
+    static void MoveOrCopy(TSharedPtr<const TData, ESPMode::ThreadSafe>& InOutData, TData& OutData)
+    {
+        if (!InOutData.IsValid())
+        {
+            OutData = TData();
+        }
+        else if (InOutData.IsUnique())
+        {
+            /// it was created mutable, and no other reader can reach it
+            OutData = MoveTemp(const_cast<TData&>(*InOutData));
+        }
+        else
+        {
+            OutData = *InOutData;
+        }
+        InOutData.Reset();
+    }
+};
+
 namespace EglTFBufferSource
 {
     enum Type
@@ -140,57 +559,180 @@ public:
 
 public:
     bool CacheBinary(uint32 InIndex, const TArray<uint8>& InData);
+    bool CacheBinary(uint32 InIndex, const uint8* InData, int64 InSize, const TSharedRef<FglTFBufferDataOwner, ESPMode::ThreadSafe>& InDataOwner);
+    bool CacheBinary(uint32 InIndex, const FString& InFilePath, int64 InOffset, int64 InSize);
     bool CacheImages(uint32 InIndex, const FString& InFileFolderRoot, const std::shared_ptr<libgltf::SImage>& InImage);
     bool CacheBuffers(uint32 InIndex, const FString& InFileFolderRoot, const std::shared_ptr<libgltf::SBuffer>& InBuffer);
     bool Cache(const FString& InFileFolderRoot, const std::shared_ptr<libgltf::SGlTF>& InglTF);
 
+    /// build the accessor descriptors, `Cache` calls it
+    bool CacheAccessors(const std::shared_ptr<libgltf::SGlTF>& InglTF);
+
+    /// count the readers of the accessors the import will read, only these decoded accessors are shared,
+    /// it walks the meshes of the scenes once and skips the draco primitives
+    void CountAccessorReaders(const std::shared_ptr<libgltf::SGlTF>& InglTF, bool InAllScenes, bool InMeshes, bool InSkins, bool InAnimations);
+
+    /// load the images and buffers when they are accessed at first instead of caching all of them,
+    /// the least recently used ones are released when the loaded size is over the budget (0 means no limit)
+    void SetLazyLoading(bool InLazyLoading, int64 InLazyLoadingBudget = 0);
+
+    /// load the cached images and buffers in the thread pool concurrently, `GetData` just waits for the one it needs
+    void Prefetch(bool InPrefetchImages, bool InPrefetchBuffers);
+
+    /// decode all draco compressed primitives of the scenes concurrently, the mesh data is taken by `FindDracoMeshData`
+    void DecodeDracoMeshes(const std::shared_ptr<libgltf::SGlTF>& InglTF, bool InAllScenes, bool bSwapYZ = true);
+
+    /// take the primitive decoded by `DecodeDracoMeshes`, it is released from the buffers
+    bool FindDracoMeshData(const libgltf::SMeshPrimitive* InMeshPrimitive, bool bSwapYZ, FglTFDracoMeshData& OutDracoMeshData) const;
+
+    /// decode a draco compressed primitive, it is loaded from or saved to the cache directory if the directory is set
+    bool DecodeDracoMesh(const std::shared_ptr<libgltf::SGlTF>& InglTF, const libgltf::SKHR_draco_mesh_compressionextension* InExtensionDraco, bool bSwapYZ, FglTFDracoMeshData& OutDracoMeshData) const;
+
+    /// the decoded draco primitives are cached in this directory by the hash of the compressed data, empty means no cache,
+    /// the least recently used files are deleted when the directory is over the max size, 0 means no limit
+    void SetDracoCacheDirectory(const FString& InDracoCacheDirectory, int64 InDracoCacheMaxSize = 0);
+
 public:
     template<EglTFBufferSource::Type SourceType>
-    const TArray<uint8>& GetData(int32 InIndex, FString& OutFilePath) const
+    TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> GetData(int32 InIndex, FString& OutFilePath) const
     {
-        if (!IndexToIndex[SourceType].Contains(InIndex)) return DataEmpty;
+        if (!IndexToIndex[SourceType].Contains(InIndex)) return nullptr;
         uint32 DataIndex = IndexToIndex[SourceType][InIndex];
         /// just one data when import a glb file
         if (bConstructByBinary) DataIndex = 0;
-        if (DataIndex >= static_cast<uint32>(Datas.Num())) return DataEmpty;
-        const TSharedPtr<FglTFBufferData>& Data = Datas[DataIndex];
-        if (!Data.IsValid()) return DataEmpty;
+        const TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> Data = GetDataByIndex(DataIndex);
+        if (!Data.IsValid() || !(*Data)) return nullptr;
         OutFilePath = Data->GetFilePath();
-        return Data->GetData();
+        return Data;
     }
 
     template<typename TElem, EglTFBufferSource::Type SourceType>
-    bool Get(int32 InIndex, TArray<TElem>& OutBufferSegment, FString& OutFilePath, int32 InStart = 0, int32 InCount = 0, int32 InStride = 0) const
+    bool Get(int32 InIndex, TArray<TElem>& OutBufferSegment, FString& OutFilePath, int64 InStart = 0, int32 InCount = 0, int32 InStride = 0) const
     {
         const int32 ElemSize = static_cast<int32>(sizeof(TElem));
         if (InStride == 0) InStride = ElemSize;
-        checkfSlow(ElemSize > InStride, TEXT("Stride is too smaller!"));
+        checkfSlow(ElemSize <= InStride, TEXT("Stride is too smaller!"));
         if (ElemSize > InStride) return false;
         if (InStart < 0) return false;
-        const TArray<uint8>& BufferSegment = GetData<SourceType>(InIndex, OutFilePath);
-        if (BufferSegment.Num() <= 0) return false;
-        if (InCount <= 0) InCount = BufferSegment.Num();
+        const TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> BufferData = GetData<SourceType>(InIndex, OutFilePath);
+        if (!BufferData.IsValid()) return false;
+        const uint8* BufferSegment = BufferData->GetData();
+        const int64 BufferSize = BufferData->GetSize();
+        if (InCount <= 0) InCount = static_cast<int32>(FMath::Min<int64>((BufferSize - InStart) / ElemSize, MAX_int32));
+        if (InCount <= 0) return false;
 
         if (InStride == ElemSize)
         {
-            if (BufferSegment.Num() < (InStart + InCount * InStride)) return false;
+            if (BufferSize < (InStart + static_cast<int64>(InCount) * InStride)) return false;
             OutBufferSegment.SetNumUninitialized(InCount);
-            FMemory::Memcpy((void*)OutBufferSegment.GetData(), (void*)(BufferSegment.GetData() + InStart), InCount * sizeof(TElem));
+            FMemory::Memcpy((void*)OutBufferSegment.GetData(), (const void*)(BufferSegment + InStart), static_cast<SIZE_T>(InCount) * sizeof(TElem));
         }
         else
         {
-            const int32 StartIndex = static_cast<int32>(static_cast<float>(InStart) / InStride);
-            const int32 StartOffset = InStart - StartIndex * InStride;
-            if (BufferSegment.Num() < (StartIndex * InStride + InCount * InStride)) return false;
+            /// the last element doesn't need to fill the whole stride
+            if (BufferSize < (InStart + static_cast<int64>(InCount - 1) * InStride + ElemSize)) return false;
             OutBufferSegment.SetNumUninitialized(InCount);
-            for (int32 i = StartIndex; i < InCount; ++i)
-            {
-                FMemory::Memcpy((void*)(OutBufferSegment.GetData() + i), (void*)(BufferSegment.GetData() + StartOffset + i * InStride), ElemSize);
-            }
+            Gather((uint8*)OutBufferSegment.GetData(), BufferSegment + InStart, ElemSize, InStride, InCount);
+        }
+        return true;
+    }
+
+    template<typename TElem>
+    bool GetAccessorView(const std::shared_ptr<libgltf::SGlTF>& InglTF, int32 InBufferViewIndex, int64 InOffset, int32 InCount, TglTFAccessorView<TElem>& OutAccessorView, FString& OutFilePath) const
+    {
+        if (!InglTF) return false;
+        if (InBufferViewIndex < 0 || InBufferViewIndex >= static_cast<int32>(InglTF->bufferViews.size())) return false;
+        const std::shared_ptr<libgltf::SBufferView>& BufferView = InglTF->bufferViews[InBufferViewIndex];
+        if (!BufferView || !BufferView->buffer) return false;
+        if (InOffset < 0 || InCount <= 0) return false;
+
+        const int32 ElemSize = static_cast<int32>(sizeof(TElem));
+        const int32 Stride = BufferView->byteStride > 0 ? BufferView->byteStride : ElemSize;
+        if (Stride < ElemSize) return false;
+
+        /// the last element doesn't need to fill the whole stride
+        const int64 ViewSize = InOffset + static_cast<int64>(InCount - 1) * Stride + ElemSize;
+        if (ViewSize > ToByteSize(BufferView->byteLength)) return false;
+
+        const TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> BufferData = GetData<EglTFBufferSource::Buffers>((int32)(*BufferView->buffer), OutFilePath);
+        if (!BufferData.IsValid()) return false;
+        const int64 BufferViewOffset = ToByteSize(BufferView->byteOffset);
+        if (BufferViewOffset + ViewSize > BufferData->GetSize()) return false;
+
+        const int64 Start = BufferViewOffset + InOffset;
+        OutAccessorView = TglTFAccessorView<TElem>(BufferData, BufferData->GetData() + Start, Stride, InCount);
+        return true;
+    }
+
+    const FglTFAccessorDesc* GetAccessorDesc(int32 InAccessorIndex) const
+    {
+        return Accessors.IsValidIndex(InAccessorIndex) ? &Accessors[InAccessorIndex] : nullptr;
+    }
+
+    /// share the decoded accessor if another primitive or mesh decoded it with the same key,
+    /// each call consumes one reader of the accessor, the decoded datas are released after the last reader
+    template<typename TDecoded>
+    TSharedPtr<const TDecoded, ESPMode::ThreadSafe> FindDecodedAccessor(int32 InAccessorIndex, uint32 InDecodeKey) const
+    {
+        FScopeLock DecodedAccessorsScopeLock(&DecodedAccessorsLock);
+        if (!AccessorReaders.IsValidIndex(InAccessorIndex) || AccessorReaders[InAccessorIndex] <= 0) return nullptr;
+
+        TSharedPtr<const TDecoded, ESPMode::ThreadSafe> Decoded;
+        for (const TPair<uint32, TSharedPtr<const FglTFDecodedAccessor, ESPMode::ThreadSafe>>& DecodedAccessorPair : DecodedAccessors[InAccessorIndex])
+        {
+            if (DecodedAccessorPair.Key != InDecodeKey) continue;
+            Decoded = static_cast<const TglTFDecodedAccessor<TDecoded>*>(DecodedAccessorPair.Value.Get())->Data;
+            break;
         }
+        if (--AccessorReaders[InAccessorIndex] <= 0)
+        {
+            DecodedAccessors[InAccessorIndex].Empty();
+        }
+        return Decoded;
+    }
+
+    /// whether the decoded accessor is worth keeping for the other readers
+    bool HasDecodedAccessorReaders(int32 InAccessorIndex) const
+    {
+        FScopeLock DecodedAccessorsScopeLock(&DecodedAccessorsLock);
+        return AccessorReaders.IsValidIndex(InAccessorIndex) && AccessorReaders[InAccessorIndex] > 0;
+    }
+
+    /// keep the decoded accessor if it has other readers, it is shared without copying
+    template<typename TDecoded>
+    void AddDecodedAccessor(int32 InAccessorIndex, uint32 InDecodeKey, const TSharedRef<const TDecoded, ESPMode::ThreadSafe>& InData) const
+    {
+        TSharedPtr<const FglTFDecodedAccessor, ESPMode::ThreadSafe> DecodedAccessor = MakeShareable(new TglTFDecodedAccessor<TDecoded>(InData));
+        FScopeLock DecodedAccessorsScopeLock(&DecodedAccessorsLock);
+        if (!AccessorReaders.IsValidIndex(InAccessorIndex) || AccessorReaders[InAccessorIndex] <= 0) return;
+        DecodedAccessors[InAccessorIndex].Emplace(InDecodeKey, DecodedAccessor);
+    }
+
+    template<typename TElem>
+    bool GetAccessorView(const FglTFAccessorDesc& InAccessorDesc, TglTFAccessorView<TElem>& OutAccessorView, FString& OutFilePath) const
+    {
+        checkSlow(sizeof(TElem) == InAccessorDesc.ElemSize);
+        if (!InAccessorDesc.bValid || InAccessorDesc.BufferIndex == INDEX_NONE || InAccessorDesc.Count <= 0) return false;
+
+        const TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> BufferData = GetData<EglTFBufferSource::Buffers>(InAccessorDesc.BufferIndex, OutFilePath);
+        if (!BufferData.IsValid()) return false;
+        /// the range was checked with the declared buffer length, but the loaded data may be shorter
+        if (InAccessorDesc.Offset + InAccessorDesc.GetByteLength() > BufferData->GetSize()) return false;
+
+        OutAccessorView = TglTFAccessorView<TElem>(BufferData, BufferData->GetData() + InAccessorDesc.Offset, InAccessorDesc.Stride, InAccessorDesc.Count);
         return true;
     }
 
+    /// libgltf reads the byte offsets and lengths as `int32_t`, the values over 2 GB are wrapped to negative,
+    /// a glb is 4 GB at most, so they are read back as unsigned without any loss
+    static int64 ToByteSize(int32 InByteSize)
+    {
+        return static_cast<int64>(static_cast<uint32>(InByteSize));
+    }
+
+    /// de-interleave `InCount` elements of `InElemSize` bytes from a strided buffer into a packed buffer
+    static void Gather(uint8* OutData, const uint8* InData, int32 InElemSize, int32 InStride, int32 InCount);
+
     template<typename TElem>
     bool GetImageData(const std::shared_ptr<libgltf::SGlTF>& InglTF, int32 InImageIndex, TArray<TElem>& OutBufferSegment, FString& OutFilePath) const
     {
@@ -213,21 +755,80 @@ public:
     }
 
     template<typename TElem>
-    bool GetBufferViewData(const std::shared_ptr<libgltf::SGlTF>& InglTF, int32 InBufferViewIndex, TArray<TElem>& OutBufferSegment, FString& OutFilePath, int32 InOffset = 0, int32 InCount = 0) const
+    bool GetBufferViewData(const std::shared_ptr<libgltf::SGlTF>& InglTF, int32 InBufferViewIndex, TArray<TElem>& OutBufferSegment, FString& OutFilePath, int64 InOffset = 0, int32 InCount = 0) const
     {
         if (!InglTF) return false;
         if (InBufferViewIndex < 0 || InBufferViewIndex >= static_cast<int32>(InglTF->bufferViews.size())) return false;
         const std::shared_ptr<libgltf::SBufferView>& BufferView = InglTF->bufferViews[InBufferViewIndex];
         if (!BufferView || !BufferView->buffer) return false;
         int32 BufferIndex = (int32)(*BufferView->buffer);
-        return Get<TElem, EglTFBufferSource::Buffers>(BufferIndex, OutBufferSegment, OutFilePath, BufferView->byteOffset + InOffset, InCount != 0 ? InCount : BufferView->byteLength, BufferView->byteStride);
+        const int32 Count = InCount != 0 ? InCount : static_cast<int32>(FMath::Min<int64>(ToByteSize(BufferView->byteLength) / sizeof(TElem), MAX_int32));
+        return Get<TElem, EglTFBufferSource::Buffers>(BufferIndex, OutBufferSegment, OutFilePath, ToByteSize(BufferView->byteOffset) + InOffset, Count, BufferView->byteStride);
     }
 
 private:
+    struct FDataSource
+    {
+        FString FileFolderRoot;
+        /// refers to the uri in the glTF, the data uri is too big to copy
+        std::shared_ptr<const libgltf::string_t> Uri;
+    };
+
+    struct FPrefetchingData
+    {
+        FPrefetchingData()
+            : Data()
+            , Size(0)
+        {
+            //
+        }
+
+        TSharedFuture<TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe>> Data;
+        /// counted in `LoadedDataSize` until the data is loaded
+        int64 Size;
+    };
+
+    TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe> GetDataByIndex(uint32 InDataIndex) const;
+    void ReleaseLeastRecentlyUsed(uint32 InDataIndexInUse) const;
+    /// the size of the data before loading it, the size of the file or the size of the decoded data uri
+    static int64 GetDataSourceSize(const FDataSource& InDataSource);
+    /// delete the least recently used files in the draco cache directory until it is within the max size
+    void TrimDracoCache() const;
+
+private:
+
     bool bConstructByBinary;
+    bool bLazyLoading;
+    int64 LazyLoadingBudget;
     TMap<uint32, uint32> IndexToIndex[EglTFBufferSource::Max];
-    TArray<TSharedPtr<FglTFBufferData>> Datas;
-    const TArray<uint8> DataEmpty;
+    TArray<FDataSource> DataSources;
+
+    /// the datas are loaded and released in `GetData` when the lazy loading is enabled
+    mutable FCriticalSection DatasLock;
+    mutable TArray<TSharedPtr<FglTFBufferData, ESPMode::ThreadSafe>> Datas;
+    /// the indices of the lazily loaded datas, in no particular order
+    mutable TArray<uint32> LoadedDataIndices;
+    mutable int64 LoadedDataSize;
+    /// indexed by the data index, stamped with `DataUseCount` on each use, the least recently used one has the smallest stamp
+    mutable TArray<uint64> DataLastUses;
+    mutable uint64 DataUseCount;
+    /// the datas are loading in the thread pool
+    mutable TMap<uint32, FPrefetchingData> PrefetchingDatas;
+
+    /// indexed by the accessor index
+    TArray<FglTFAccessorDesc> Accessors;
+
+    /// indexed by the accessor index too
+    mutable FCriticalSection DecodedAccessorsLock;
+    mutable TArray<int32> AccessorReaders;
+    mutable TArray<TArray<TPair<uint32, TSharedPtr<const FglTFDecodedAccessor, ESPMode::ThreadSafe>>>> DecodedAccessors;
+
+    FString DracoCacheDirectory;
+    int64 DracoCacheMaxSize;
+
+    /// the decoded draco primitives
+    mutable FCriticalSection DracoMeshDatasLock;
+    mutable TMap<const libgltf::SMeshPrimitive*, TSharedPtr<FglTFDracoMeshData, ESPMode::ThreadSafe>> DracoMeshDatas;
 };
 
 struct GLTFFORUE4_API FglTFAnimationSequenceKeyData
@@ -315,6 +916,30 @@ public:
         TArray<TArray<FVector4>>& OutMorphTargetsVertexTangents,
         TArray<FVector2D> OutVertexTexcoords[MAX_TEXCOORDS],
         bool bSwapYZ = true);
+    /// the morph targets are sparse if their accessors are sparse without the buffer view
+    static bool GetStaticMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+        const FglTFBuffers& InBuffers,
+        TArray<uint32>& OutTriangleIndices,
+        TArray<FVector>& OutVertexPositions,
+        TArray<TglTFSparseArray<FVector>>& OutMorphTargetsVertexPositions,
+        TArray<FVector>& OutVertexNormals,
+        TArray<TglTFSparseArray<FVector>>& OutMorphTargetsVertexNormals,
+        TArray<FVector4>& OutVertexTangents,
+        TArray<TglTFSparseArray<FVector4>>& OutMorphTargetsVertexTangents,
+        TArray<FVector2D> OutVertexTexcoords[MAX_TEXCOORDS],
+        bool bSwapYZ = true);
+    /// the attributes are shared with the other readers of the same accessors without copying
+    static bool GetStaticMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+        const FglTFBuffers& InBuffers,
+        FglTFMeshData& OutMeshData,
+        bool bSwapYZ = true);
+    static bool GetSkeletalMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+        const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
+        const FglTFBuffers& InBuffers,
+        FglTFMeshData& OutMeshData,
+        bool bSwapYZ = true);
     static bool GetSkeletalMeshData(const std::shared_ptr<libgltf::SGlTF>& InGlTF,
         const std::shared_ptr<libgltf::SMeshPrimitive>& InMeshPrimitive,
         const FglTFBuffers& InBuffers,
@@ -339,7 +964,13 @@ public:
     static bool GetNodeRelativeTransforms(const std::shared_ptr<libgltf::SGlTF>& InGlTF, TArray<FTransform>& OutRelativeTransforms, bool bSwapYZ = true);
     static bool GetNodeParentIndicesAndTransforms(const std::shared_ptr<libgltf::SGlTF>& InGlTF, TArray<int32>& OutParentIndices, TArray<FTransform>& OutRelativeTransforms, TArray<FTransform>& OutAbsoluteTransforms, bool bSwapYZ = true);
     static bool GetNodeInfos(const std::shared_ptr<libgltf::SGlTF>& InGlTF, TMap<int32, FglTFImporterNodeInfo>& OutNodeInfos, bool bSwapYZ = true);
+    /// the instance transforms of `EXT_mesh_gpu_instancing` relative to the node, returns false if the node doesn't have it
+    static bool GetNodeInstanceTransforms(const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SNode>& InNode, const FglTFBuffers& InBuffers, TArray<FTransform>& OutInstanceTransforms, bool bSwapYZ = true);
     static bool SpawnStaticMeshActor(class UWorld* InWorld, const FTransform& InTransform, class UStaticMesh* InStaticMesh);
+    /// spawn an actor with a hierarchical instanced static mesh component, the transforms are in the world space
+    static bool SpawnInstancedStaticMeshActor(class UWorld* InWorld, const TArray<FTransform>& InTransforms, class UStaticMesh* InStaticMesh);
+    /// spawn the actors without constructing them at first, then construct and attach them in a batch, in the current level if `InLevel` is null
+    static bool SpawnActors(class UWorld* InWorld, const TArray<FglTFImporterSpawnRequest>& InSpawnRequests, class ULevel* InLevel = nullptr);
     static bool SpawnSkeletalMeshActor(class UWorld* InWorld, const FTransform& InTransform, class USkeletalMesh* InSkeletalMesh);
 
 public:
@@ -355,6 +986,14 @@ public:
     static TextureAddress WrapTToTextureAddress(int32 InValue);
     static ERichCurveInterpMode StringToRichCurveInterpMode(const FString& InInterpolation);
 
+    /// converts `InCount` elements of an accessor at `InData` with the vector kernel, or with the per-element conversion operators
+    /// if `bPerElement`, the accessor's type follows the engine's type, it is used to compare the both
+    static bool ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<float>& OutDatas);
+    static bool ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<FVector2D>& OutDatas);
+    static bool ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<FVector>& OutDatas);
+    static bool ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<FVector4>& OutDatas);
+    static bool ConvertAccessorElements(const uint8* InData, int32 InStride, int32 InCount, int32 InComponentType, bool bNormalized, bool bSwapYZ, bool bInverseX, bool bPerElement, TArray<FQuat>& OutDatas);
+
     template<typename TElem>
     static void MergeMorphTarget(TArray<TElem>& InOutOrigin, const TArray<TElem>& InDeltas, float InWeightOrigin, float InWeightDelta)
     {
@@ -375,6 +1014,39 @@ public:
         }
     }
 
+    template<typename TElem>
+    static void MergeMorphTarget(TArray<TElem>& InOutOrigin, const TArray<TglTFSparseArray<TElem>>& InMorphTargets, const std::vector<float>& InWeights)
+    {
+        const int32_t MinNum = FMath::Min(InMorphTargets.Num(), static_cast<int32_t>(InWeights.size()));
+        for (int32_t i = 0; i < MinNum; ++i)
+        {
+            InMorphTargets[i].AddTo(InOutOrigin, InWeights[i]);
+        }
+    }
+
+    template<typename TElem>
+    static void MergeMorphTarget(TArray<TElem>& InOutOrigin, const TArray<TSharedPtr<const TglTFSparseArray<TElem>, ESPMode::ThreadSafe>>& InMorphTargets, const std::vector<float>& InWeights)
+    {
+        const int32_t MinNum = FMath::Min(InMorphTargets.Num(), static_cast<int32_t>(InWeights.size()));
+        for (int32_t i = 0; i < MinNum; ++i)
+        {
+            if (!InMorphTargets[i].IsValid()) continue;
+            InMorphTargets[i]->AddTo(InOutOrigin, InWeights[i]);
+        }
+    }
+
+    /// whether `MergeMorphTarget` changes anything, so the shared attributes are only copied when they are merged
+    template<typename TMorphTarget>
+    static bool HasMorphTargetWeights(const TArray<TMorphTarget>& InMorphTargets, const std::vector<float>& InWeights)
+    {
+        const int32_t MinNum = FMath::Min(InMorphTargets.Num(), static_cast<int32_t>(InWeights.size()));
+        for (int32_t i = 0; i < MinNum; ++i)
+        {
+            if (InWeights[i] != 0.0f) return true;
+        }
+        return false;
+    }
+
     template<typename TElem>
     static void MergeMorphTarget(TArray<TArray<TElem>>& InOutMorphTargets, const TArray<TElem>& InOrigin, float InWeight)
     {
@@ -56,6 +56,9 @@ struct GLTFFORUE4_API FglTFImporterOptionsDetailsStored
 
     UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay)
     bool bUseFullPrecisionUVs;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay, meta = (EditCondition = bImportStaticMesh, ToolTip = "Write the static mesh to the mesh description directly instead of the raw mesh, needs UE 4.24 or later and is on by default there"))
+    bool bUseMeshDescription;
     
     UPROPERTY(EditAnywhere, Config, Category = "Mesh", meta = (EditCondition = bImportSkeletalMesh, ToolTip = "Import the animation for skeletal mesh or morph target?"))
     bool bImportAnimation;
@@ -65,6 +68,15 @@ struct GLTFFORUE4_API FglTFImporterOptionsDetailsStored
     
     UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay, meta = (EditCondition = bImportSkeletalMesh))
     bool bCreatePhysicsAsset;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Mesh", meta = (EditCondition = bImportStaticMesh, ToolTip = "Merge the static meshes of the nodes in one or a few static meshes, the sections are grouped by the material"))
+    bool bMergeStaticMeshes;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay, meta = (EditCondition = bMergeStaticMeshes, ClampMin = -1, ToolTip = "The index of the node whose subtree is merged, -1 means all nodes of the imported scenes"))
+    int32 MergeStaticMeshesRootNode;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay, meta = (EditCondition = bMergeStaticMeshes, ClampMin = 1, ToolTip = "Start a new merged static mesh when the triangles exceed it"))
+    int32 MaxTrianglesPerMergedMesh;
     
     /// material options
     UPROPERTY(EditAnywhere, Config, Category = "Material", meta = (EditCondition = bImportMaterial))
@@ -126,6 +138,9 @@ public:
 
     UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay)
     bool bUseFullPrecisionUVs;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay, meta = (EditCondition = bImportStaticMesh, ToolTip = "Write the static mesh to the mesh description directly instead of the raw mesh, needs UE 4.24 or later and is on by default there"))
+    bool bUseMeshDescription;
     
     UPROPERTY(EditAnywhere, Config, Category = "Mesh", meta = (EditCondition = bImportSkeletalMesh, ToolTip = "Import the animation for skeletal mesh or morph target?"))
     bool bImportAnimation;
@@ -135,6 +150,15 @@ public:
     
     UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay, meta = (EditCondition = bImportSkeletalMesh))
     bool bCreatePhysicsAsset;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Mesh", meta = (EditCondition = bImportStaticMesh, ToolTip = "Merge the static meshes of the nodes in one or a few static meshes, the sections are grouped by the material"))
+    bool bMergeStaticMeshes;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay, meta = (EditCondition = bMergeStaticMeshes, ClampMin = -1, ToolTip = "The index of the node whose subtree is merged, -1 means all nodes of the imported scenes"))
+    int32 MergeStaticMeshesRootNode;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Mesh", AdvancedDisplay, meta = (EditCondition = bMergeStaticMeshes, ClampMin = 1, ToolTip = "Start a new merged static mesh when the triangles exceed it"))
+    int32 MaxTrianglesPerMergedMesh;
     
     /// material options
     UPROPERTY(EditAnywhere, Config, Category = "Material", meta = (EditCondition = bImportMaterial))
@@ -150,6 +174,27 @@ public:
     UPROPERTY(EditAnywhere, Config, Category = "Level", AdvancedDisplay, meta = (EditCondition = bImportLevel, AllowedClasses = "World", ToolTip = "Import a new level that create by the template"))
     FStringAssetReference ImportLevelTemplate;
 
+    UPROPERTY(EditAnywhere, Config, Category = "Level", meta = (EditCondition = bImportLevel, ToolTip = "Spawn one actor with the instanced components for the nodes that have the same static mesh, the actor is not attached to the actors of their parent nodes"))
+    bool bInstanceRepeatedMeshes;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Level", AdvancedDisplay, meta = (EditCondition = bImportLevel, ToolTip = "Spawn the actors after all meshes are created and attach them by the node hierarchy, a static mesh actor under a movable parent becomes movable too"))
+    bool bSpawnActorsInBatch;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Level", AdvancedDisplay, meta = (EditCondition = bImportLevel, ToolTip = "Spawn the actors in the streaming levels of a uniform grid, they are streamed by the volumes in the persistent level"))
+    bool bPartitionLevelInGrid;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Level", AdvancedDisplay, meta = (EditCondition = bPartitionLevelInGrid, ClampMin = 100.0f, ToolTip = "The size of a grid cell in centimeters"))
+    float LevelGridCellSize;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Level", AdvancedDisplay, meta = (EditCondition = bPartitionLevelInGrid, ToolTip = "Partition along the height too"))
+    bool bLevelGridIn3D;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Level", AdvancedDisplay, meta = (EditCondition = bPartitionLevelInGrid, ClampMin = 0.0f, ToolTip = "The streaming volume of a cell is expanded by the distance"))
+    float LevelGridStreamingDistance;
+
+    /// the grid partition needs the spawn requests
+    bool ShouldSpawnActorsInBatch() const { return bSpawnActorsInBatch || bPartitionLevelInGrid; }
+
     void Get(FglTFImporterOptionsDetailsStored& OutDetailsStored) const;
     void Set(const FglTFImporterOptionsDetailsStored& InDetailsStored);
 };
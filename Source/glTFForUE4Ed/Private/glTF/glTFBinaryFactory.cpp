@@ -12,10 +12,29 @@
 #include <Misc/FileHelper.h>
 #endif
 #include <Misc/Paths.h>
+#include <HAL/PlatformFilemanager.h>
+#include <GenericPlatform/GenericPlatformFile.h>
 
-#define GLTF_FILE_SIZE_MAX      0x7FFFFFFF
+/// the length in the header is `uint32`
+#define GLTF_FILE_SIZE_MAX      0xFFFFFFFF
 #define GLTF_ASCII_UINT32(x)    ((((x) & 0xFF000000) >> 24) | (((x) & 0x000000FF) << 24) | (((x) & 0x00FF0000) >> 8) | (((x) & 0x0000FF00) << 8))
 
+namespace glTFForUE4Ed
+{
+    struct FglTFFileHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 Length;
+    };
+
+    struct FglTFChunkHeader
+    {
+        uint32 Length;
+        uint32 Type;
+    };
+}
+
 UglTFBinaryFactory::UglTFBinaryFactory(const FObjectInitializer& InObjectInitializer)
     : Super(InObjectInitializer)
 {
@@ -33,28 +52,29 @@ bool UglTFBinaryFactory::FactoryCanImport(const FString& InFilename)
     return FPaths::GetExtension(InFilename).Equals(TEXT("glb"), ESearchCase::IgnoreCase);
 }
 
+UObject* UglTFBinaryFactory::FactoryCreateFile(UClass* InClass, UObject* InParent, FName InName, EObjectFlags InFlags, const FString& InFilename, const TCHAR* InParms, FFeedbackContext* InWarn, bool& bOutOperationCanceled)
+{
+    ParseParms(InParms);
+    return FactoryCreateBinaryFile(InClass, InParent, InName, InFlags, nullptr, InFilename, InWarn);
+}
+
 UObject* UglTFBinaryFactory::FactoryCreateBinary(UClass* InClass, UObject* InParent, FName InName, EObjectFlags InFlags, UObject* InContext, const TCHAR* InType, const uint8*& InBuffer, const uint8* InBufferEnd, FFeedbackContext* InWarn)
 {
     if (!InClass || !InParent || !InBuffer || !InBufferEnd || InBuffer == InBufferEnd) return nullptr;
 
     uint64 BuffSize = InBufferEnd - InBuffer;
-    if (BuffSize <= 0 || BuffSize >= GLTF_FILE_SIZE_MAX)
+    if (BuffSize <= 0 || BuffSize > GLTF_FILE_SIZE_MAX)
     {
-        //TODO:
+        UE_LOG(LogglTFForUE4Ed, Error, TEXT("Invalid size(%llu) of the glb buffer!"), BuffSize);
         return nullptr;
     }
 
-    struct FglTFFileHeader
-    {
-        uint32 Magic;
-        uint32 Version;
-        uint32 Length;
-    };
+    using namespace glTFForUE4Ed;
 
     uint64 Offset = 0;
     if (BuffSize < sizeof(FglTFFileHeader))
     {
-        //TODO:
+        UE_LOG(LogglTFForUE4Ed, Error, TEXT("The glb buffer is too small(%llu) to have a header!"), BuffSize);
         return nullptr;
     }
 
@@ -66,28 +86,30 @@ UObject* UglTFBinaryFactory::FactoryCreateBinary(UClass* InClass, UObject* InPar
         || glTFFileHeader.Version != 2
         || glTFFileHeader.Length != BuffSize)
     {
-        //TODO:
+        UE_LOG(LogglTFForUE4Ed, Error, TEXT("Invalid header of the glb buffer!"));
         return nullptr;
     }
 
-    struct FglTFChunkHeader
-    {
-        uint32 Length;
-        uint32 Type;
-    };
-
     FString glTFJson;
     TSharedPtr<FglTFBuffers> glTFBuffers = MakeShareable(new FglTFBuffers(true));
+    /// the BIN chunks are viewed in place, they become invalid when this function returns
+    const TSharedRef<FglTFBufferDataOwner, ESPMode::ThreadSafe> BinaryDataOwner = MakeShared<FglTFBufferDataOwner, ESPMode::ThreadSafe>();
     uint32 BinaryIndex = 0;
     while (Offset < BuffSize)
     {
+        if ((Offset + sizeof(FglTFChunkHeader)) > BuffSize)
+        {
+            UE_LOG(LogglTFForUE4Ed, Error, TEXT("The chunk header at %llu is truncated in the glb buffer!"), Offset);
+            return nullptr;
+        }
+
         FglTFChunkHeader glTFChunkHeader;
         FMemory::Memcpy(&glTFChunkHeader, InBuffer + Offset, sizeof(FglTFChunkHeader));
         Offset += sizeof(FglTFChunkHeader);
 
         if ((Offset + glTFChunkHeader.Length) > BuffSize)
         {
-            //TODO:
+            UE_LOG(LogglTFForUE4Ed, Error, TEXT("The chunk at %llu is truncated in the glb buffer, its length is %u!"), Offset, glTFChunkHeader.Length);
             return nullptr;
         }
 
@@ -98,22 +120,19 @@ UObject* UglTFBinaryFactory::FactoryCreateBinary(UClass* InClass, UObject* InPar
                 FFileHelper::BufferToString(glTFJson, InBuffer + Offset, glTFChunkHeader.Length);
                 if (glTFJson.IsEmpty())
                 {
-                    //TODO:
+                    UE_LOG(LogglTFForUE4Ed, Error, TEXT("Empty JSON chunk of the glb buffer!"));
                     return nullptr;
                 }
             }
             else
             {
-                //TODO:
+                UE_LOG(LogglTFForUE4Ed, Error, TEXT("More than one JSON chunk in the glb buffer!"));
                 return nullptr;
             }
         }
         else if (glTFChunkHeader.Type == GLTF_ASCII_UINT32('BIN\0'))
         {
-            TArray<uint8> ChunkData;
-            ChunkData.SetNumZeroed(glTFChunkHeader.Length);
-            FMemory::Memcpy(ChunkData.GetData(), InBuffer + Offset, glTFChunkHeader.Length);
-            glTFBuffers->CacheBinary(BinaryIndex++, ChunkData);
+            glTFBuffers->CacheBinary(BinaryIndex++, InBuffer + Offset, glTFChunkHeader.Length, BinaryDataOwner);
         }
 
         Offset += glTFChunkHeader.Length;
@@ -121,3 +140,89 @@ UObject* UglTFBinaryFactory::FactoryCreateBinary(UClass* InClass, UObject* InPar
 
     return FactoryCreate(InClass, InParent, InName, InFlags, InContext, InType, InWarn, glTFJson, glTFBuffers);
 }
+
+UObject* UglTFBinaryFactory::FactoryCreateBinaryFile(UClass* InClass, UObject* InParent, FName InName, EObjectFlags InFlags, UObject* InContext, const FString& InFilename, FFeedbackContext* InWarn)
+{
+    if (!InClass || !InParent) return nullptr;
+
+    using namespace glTFForUE4Ed;
+
+    TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*InFilename));
+    if (!FileHandle.IsValid())
+    {
+        UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to open the file: %s!"), *InFilename);
+        return nullptr;
+    }
+
+    const int64 FileSize = FileHandle->Size();
+    if (FileSize < static_cast<int64>(sizeof(FglTFFileHeader)) || FileSize > GLTF_FILE_SIZE_MAX)
+    {
+        UE_LOG(LogglTFForUE4Ed, Error, TEXT("Invalid size(%lld) of the glb file: %s!"), FileSize, *InFilename);
+        return nullptr;
+    }
+
+    FglTFFileHeader glTFFileHeader;
+    if (!FileHandle->Read(reinterpret_cast<uint8*>(&glTFFileHeader), sizeof(FglTFFileHeader))
+        || glTFFileHeader.Magic != GLTF_ASCII_UINT32('glTF')
+        || glTFFileHeader.Version != 2
+        || glTFFileHeader.Length != FileSize)
+    {
+        UE_LOG(LogglTFForUE4Ed, Error, TEXT("Invalid header of the glb file: %s!"), *InFilename);
+        return nullptr;
+    }
+
+    FString glTFJson;
+    TSharedPtr<FglTFBuffers> glTFBuffers = MakeShareable(new FglTFBuffers(true));
+    uint32 BinaryIndex = 0;
+    int64 Offset = sizeof(FglTFFileHeader);
+    while (Offset < FileSize)
+    {
+        FglTFChunkHeader glTFChunkHeader;
+        if ((Offset + static_cast<int64>(sizeof(FglTFChunkHeader))) > FileSize
+            || !FileHandle->Seek(Offset)
+            || !FileHandle->Read(reinterpret_cast<uint8*>(&glTFChunkHeader), sizeof(FglTFChunkHeader)))
+        {
+            UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to read the chunk header at %lld of the glb file: %s!"), Offset, *InFilename);
+            return nullptr;
+        }
+        Offset += sizeof(FglTFChunkHeader);
+
+        if ((Offset + glTFChunkHeader.Length) > FileSize)
+        {
+            UE_LOG(LogglTFForUE4Ed, Error, TEXT("Invalid length of the chunk at %lld of the glb file: %s!"), Offset, *InFilename);
+            return nullptr;
+        }
+
+        if (glTFChunkHeader.Type == GLTF_ASCII_UINT32('JSON'))
+        {
+            TArray<uint8> JsonBuffer;
+            JsonBuffer.SetNumUninitialized(glTFChunkHeader.Length);
+            if (!glTFJson.IsEmpty() || !FileHandle->Read(JsonBuffer.GetData(), JsonBuffer.Num()))
+            {
+                UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to read the JSON chunk of the glb file: %s!"), *InFilename);
+                return nullptr;
+            }
+            FFileHelper::BufferToString(glTFJson, JsonBuffer.GetData(), JsonBuffer.Num());
+            if (glTFJson.IsEmpty())
+            {
+                UE_LOG(LogglTFForUE4Ed, Error, TEXT("Empty JSON chunk of the glb file: %s!"), *InFilename);
+                return nullptr;
+            }
+        }
+        else if (glTFChunkHeader.Type == GLTF_ASCII_UINT32('BIN\0'))
+        {
+            /// map the chunk in place, the pages are loaded when the accessors read them
+            if (!glTFBuffers->CacheBinary(BinaryIndex++, InFilename, Offset, glTFChunkHeader.Length))
+            {
+                UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to load the BIN chunk of the glb file: %s!"), *InFilename);
+                return nullptr;
+            }
+        }
+
+        Offset += glTFChunkHeader.Length;
+    }
+    FileHandle.Reset();
+
+    const FString FileExtension = FPaths::GetExtension(InFilename);
+    return FactoryCreate(InClass, InParent, InName, InFlags, InContext, *FileExtension, InWarn, glTFJson, glTFBuffers);
+}
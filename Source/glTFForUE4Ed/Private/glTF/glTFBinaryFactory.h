@@ -16,5 +16,9 @@ public:
     // End UFactory Interface
 
 public:
+    virtual UObject* FactoryCreateFile(UClass* InClass, UObject* InParent, FName InName, EObjectFlags InFlags, const FString& InFilename, const TCHAR* InParms, FFeedbackContext* InWarn, bool& bOutOperationCanceled) override;
     virtual UObject* FactoryCreateBinary(UClass* InClass, UObject* InParent, FName InName, EObjectFlags InFlags, UObject* InContext, const TCHAR* InType, const uint8*& InBuffer, const uint8* InBufferEnd, FFeedbackContext* InWarn);
+
+    /// read the chunks from the file, the BIN chunks are not loaded into the memory
+    virtual UObject* FactoryCreateBinaryFile(UClass* InClass, UObject* InParent, FName InName, EObjectFlags InFlags, UObject* InContext, const FString& InFilename, FFeedbackContext* InWarn);
 };
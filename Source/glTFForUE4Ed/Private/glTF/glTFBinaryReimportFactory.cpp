@@ -82,19 +82,9 @@ EReimportResult::Type UglTFBinaryReimportFactory::Reimport(UObject* Obj)
         return EReimportResult::Failed;
     }
 
-    TArray<uint8> glTFBinary;
-    if (!FFileHelper::LoadFileToArray(glTFBinary, *AssetImportFilename))
-    {
-        UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to load the file: %s!"), *AssetImportFilename);
-        return EReimportResult::Failed;
-    }
-    /// add `\0` as the end of the file
-    glTFBinary.Emplace('\0');
-
     Super::CurrentFilename = AssetImportFilename;
     const FString BaseFilename = FglTFImporter::SanitizeObjectName(FPaths::GetBaseFilename(AssetImportFilename));
-    const uint8* glTFBinaryBuffer = &glTFBinary[0];
-    UObject* RenewObject = Super::FactoryCreateBinary(Obj->GetClass(), Obj->GetOuter(), FName(*BaseFilename), Obj->GetFlags(), Obj, nullptr, glTFBinaryBuffer, &glTFBinary.Last(), nullptr);
+    UObject* RenewObject = Super::FactoryCreateBinaryFile(Obj->GetClass(), Obj->GetOuter(), FName(*BaseFilename), Obj->GetFlags(), Obj, AssetImportFilename, nullptr);
     if (RenewObject != Obj)
     {
         return EReimportResult::Failed;
@@ -6,6 +6,7 @@
 #include "glTF/glTFImporterOptions.h"
 #include "glTF/glTFImporterOptionsWindowEd.h"
 #include "glTF/glTFImporterEd.h"
+#include "glTFForUE4Settings.h"
 
 #include <Engine/StaticMesh.h>
 #include <Engine/SkeletalMesh.h>
@@ -119,8 +120,38 @@ UObject* UglTFFactory::FactoryCreate(UClass* InClass, UObject* InParent, FName I
         InglTFBuffers = MakeShared<FglTFBuffers>();
     }
 
+    const UglTFForUE4Settings* glTFForUE4Settings = GetDefault<UglTFForUE4Settings>();
+    /// the prefetching needs the buffers are not loaded when caching
+    InglTFBuffers->SetLazyLoading(glTFForUE4Settings->bLazyLoadBuffers || glTFForUE4Settings->bPrefetchBuffers
+        , glTFForUE4Settings->bLazyLoadBuffers ? static_cast<int64>(glTFForUE4Settings->LazyLoadBuffersBudgetInMB) * 1024 * 1024 : 0);
+
     const FString FolderPathInOS = FPaths::GetPath(glTFImporterOptions->FilePathInOS);
     InglTFBuffers->Cache(FolderPathInOS, GlTF);
+    {
+        const UglTFImporterOptionsDetails* Details = glTFImporterOptions->Details;
+        InglTFBuffers->CountAccessorReaders(GlTF, Details->bImportAllScene
+            , Details->bImportStaticMesh || Details->bImportSkeletalMesh
+            , Details->bImportSkeletalMesh
+            , Details->bImportSkeletalMesh && Details->bImportAnimation);
+    }
+    if (glTFForUE4Settings->bPrefetchBuffers)
+    {
+        const bool bPrefetchImages = glTFImporterOptions->Details->bImportMaterial && glTFImporterOptions->Details->bImportTexture;
+        InglTFBuffers->Prefetch(bPrefetchImages, true);
+    }
+    if (glTFImporterOptions->Details->bImportStaticMesh || glTFImporterOptions->Details->bImportSkeletalMesh)
+    {
+        if (glTFForUE4Settings->bCacheDracoMeshes)
+        {
+            const int64 DracoCacheMaxSize = static_cast<int64>(glTFForUE4Settings->DracoMeshesCacheSizeInMB) * 1024 * 1024;
+#if ENGINE_MINOR_VERSION <= 17
+            InglTFBuffers->SetDracoCacheDirectory(FPaths::GameSavedDir() / TEXT("glTFForUE4") / TEXT("DracoCache"), DracoCacheMaxSize);
+#else
+            InglTFBuffers->SetDracoCacheDirectory(FPaths::ProjectSavedDir() / TEXT("glTFForUE4") / TEXT("DracoCache"), DracoCacheMaxSize);
+#endif
+        }
+        InglTFBuffers->DecodeDracoMeshes(GlTF, glTFImporterOptions->Details->bImportAllScene);
+    }
 
     return FglTFImporterEd::Get(this, InParent, InName, InFlags, InWarn)->Create(glTFImporterOptions, GlTF, *InglTFBuffers, FeedbackTaskWrapper);
 }
@@ -7,6 +7,20 @@
 #include "glTF/glTFImporterEdSkeletalMesh.h"
 
 #include <EditorFramework/AssetImportData.h>
+#include <ActorFactories/ActorFactory.h>
+#include <Builders/CubeBuilder.h>
+#include <AssetRegistryModule.h>
+#include <Engine/StaticMesh.h>
+#include <Engine/SkeletalMesh.h>
+#include <Engine/LevelStreamingVolume.h>
+#include <EditorLevelUtils.h>
+#include <LevelUtils.h>
+#include <FileHelpers.h>
+#if ENGINE_MINOR_VERSION <= 20
+#include <Engine/LevelStreamingKismet.h>
+#else
+#include <Engine/LevelStreamingDynamic.h>
+#endif
 
 #define LOCTEXT_NAMESPACE "glTFForUE4EdModule"
 
@@ -69,7 +83,8 @@ UObject* FglTFImporterEd::Create(const TWeakPtr<FglTFImporterOptions>& InglTFImp
     }
 
     FglTFImporterCollection glTFImporterCollection;
-    if (!FglTFImporter::GetNodeInfos(InGlTF, glTFImporterCollection.NodeInfos))
+    glTFImporterCollection.Reserve(InGlTF);
+    if (!FglTFImporter::GetNodeParentIndicesAndTransforms(InGlTF, glTFImporterCollection.NodeParentIndices, glTFImporterCollection.NodeRelativeTransforms, glTFImporterCollection.NodeAbsoluteTransforms))
     {
         //TODO: print a message
         return nullptr;
@@ -113,27 +128,111 @@ UObject* FglTFImporterEd::Create(const TWeakPtr<FglTFImporterOptions>& InglTFImp
     {
         const FVector ScaleVector(glTFImporterOptions->Details->MeshScaleRatio);
         const FTransform ScaleTransform(FQuat::Identity, FVector::ZeroVector, ScaleVector);
-        for (TPair<int32, FglTFImporterNodeInfo>& NodeInfo : glTFImporterCollection.NodeInfos)
+        for (FTransform& NodeAbsoluteTransform : glTFImporterCollection.NodeAbsoluteTransforms)
         {
-            FglTFImporterNodeInfo& NodeInfoValue = NodeInfo.Value;
             if (glTFImporterOptions->Details->bApplyAbsoluteTransform)
             {
-                NodeInfoValue.AbsoluteTransform *= ScaleTransform;
+                NodeAbsoluteTransform *= ScaleTransform;
             }
             else
             {
-                NodeInfoValue.AbsoluteTransform.ScaleTranslation(ScaleVector);
+                NodeAbsoluteTransform.ScaleTranslation(ScaleVector);
             }
         }
     }
 
+    /// the merged nodes are skipped when the nodes are created
+    TArray<UStaticMesh*> MergedStaticMeshes;
+    if (glTFImporterOptions->Details->bImportStaticMesh && glTFImporterOptions->Details->bMergeStaticMeshes)
+    {
+        TArray<int32> MergedRootNodeIds;
+        if (glTFImporterOptions->Details->MergeStaticMeshesRootNode == INDEX_NONE)
+        {
+            for (const std::shared_ptr<libgltf::SScene>& ScenePtr : Scenes)
+            {
+                for (const std::shared_ptr<libgltf::SGlTFId>& NodeIdPtr : ScenePtr->nodes)
+                {
+                    if (NodeIdPtr) MergedRootNodeIds.Add((int32)(*NodeIdPtr));
+                }
+            }
+        }
+        else if (glTFImporterCollection.HasNodeInfo(glTFImporterOptions->Details->MergeStaticMeshesRootNode))
+        {
+            MergedRootNodeIds.Add(glTFImporterOptions->Details->MergeStaticMeshesRootNode);
+        }
+        else
+        {
+            UE_LOG(LogglTFForUE4Ed, Error, TEXT("The root node (%d) to merge the static meshes is invalid!"), glTFImporterOptions->Details->MergeStaticMeshesRootNode);
+        }
+        FglTFImporterEdStaticMesh::Get(InputFactory, InputParent, InputName, InputFlags, FeedbackContext)
+            ->CreateMergedStaticMeshes(InglTFImporterOptions, InGlTF, MergedRootNodeIds, InglTFBuffers, MergedStaticMeshes, glTFImporterCollection);
+    }
+
     UObject* CreatedObject = nullptr;
+    for (UStaticMesh* MergedStaticMesh : MergedStaticMeshes)
+    {
+        FglTFImporterEd::UpdateAssetImportData(MergedStaticMesh, InglTFImporterOptions);
+        if (!CreatedObject) CreatedObject = MergedStaticMesh;
+        if (!glTFImporterOptions->Details->bImportLevel) continue;
+        /// the transforms are baked in the merged static mesh
+        if (glTFImporterOptions->Details->ShouldSpawnActorsInBatch())
+        {
+            FglTFImporterSpawnRequest SpawnRequest;
+            SpawnRequest.StaticMesh = MergedStaticMesh;
+            glTFImporterCollection.AddSpawnRequest(INDEX_NONE, MoveTemp(SpawnRequest));
+        }
+        else
+        {
+            SpawnStaticMeshActor(glTFImporterCollection.TargetWorld, FTransform::Identity, MergedStaticMesh);
+        }
+    }
+
     for (const std::shared_ptr<libgltf::SScene>& ScenePtr : Scenes)
     {
         UObject* ObjectNode = CreateNodes(InglTFImporterOptions, InGlTF, ScenePtr->nodes, InglTFBuffers, glTFImporterCollection);
         if (!CreatedObject) CreatedObject = ObjectNode;
     }
 
+    /// the nodes that have the same static mesh are instanced by one actor, the instances are in the world space
+    /// and the nodes may have different parents, so the actor isn't attached to any of them and the hierarchy is flattened
+    for (int32 MeshId = 0; MeshId < glTFImporterCollection.StaticMeshInstanceTransforms.Num(); ++MeshId)
+    {
+        const TArray<FTransform>& InstanceTransforms = glTFImporterCollection.StaticMeshInstanceTransforms[MeshId];
+        UStaticMesh* StaticMesh = nullptr;
+        if (InstanceTransforms.Num() <= 0 || !glTFImporterCollection.FindStaticMesh(MeshId, StaticMesh) || !StaticMesh) continue;
+        if (glTFImporterOptions->Details->ShouldSpawnActorsInBatch())
+        {
+            FglTFImporterSpawnRequest SpawnRequest;
+            SpawnRequest.StaticMesh = StaticMesh;
+            if (InstanceTransforms.Num() == 1)
+            {
+                SpawnRequest.Transform = InstanceTransforms[0];
+            }
+            else
+            {
+                SpawnRequest.InstanceTransforms = InstanceTransforms;
+            }
+            glTFImporterCollection.AddSpawnRequest(INDEX_NONE, MoveTemp(SpawnRequest));
+        }
+        else if (InstanceTransforms.Num() == 1)
+        {
+            SpawnStaticMeshActor(glTFImporterCollection.TargetWorld, InstanceTransforms[0], StaticMesh);
+        }
+        else
+        {
+            SpawnInstancedStaticMeshActor(glTFImporterCollection.TargetWorld, InstanceTransforms, StaticMesh);
+        }
+    }
+
+    if (glTFImporterCollection.SpawnRequests.Num() > 0 && glTFImporterOptions->Details->bPartitionLevelInGrid)
+    {
+        CreateStreamingLevels(InglTFImporterOptions, glTFImporterCollection);
+    }
+    else if (glTFImporterCollection.SpawnRequests.Num() > 0)
+    {
+        SpawnActors(glTFImporterCollection.TargetWorld, glTFImporterCollection.SpawnRequests);
+    }
+
     return CreatedObject;
 }
 
@@ -163,15 +262,18 @@ UObject* FglTFImporterEd::CreateNode(const TWeakPtr<FglTFImporterOptions>& InglT
     const TSharedPtr<FglTFImporterOptions> glTFImporterOptions = InglTFImporterOptions.Pin();
     check(glTFImporterOptions->Details);
 
-    const FglTFImporterNodeInfo& NodeInfo = InOutglTFImporterCollection.FindNodeInfo(glTFNodeId);
+    /// the actor of the node is attached to the actor of its nearest ancestor
+    InOutglTFImporterCollection.InheritSpawnRequest(glTFNodeId);
+
+    const FTransform& NodeAbsoluteTransform = InOutglTFImporterCollection.GetNodeAbsoluteTransform(glTFNodeId);
     const FVector ScaleVector(glTFImporterOptions->Details->MeshScaleRatio);
     const FTransform ScaleTransform(FQuat::Identity, FVector::ZeroVector, ScaleVector);
     const FTransform TransformMesh = glTFImporterOptions->Details->bApplyAbsoluteTransform
-        ? NodeInfo.AbsoluteTransform
+        ? NodeAbsoluteTransform
         : ScaleTransform;
     const FTransform TransformActor = glTFImporterOptions->Details->bApplyAbsoluteTransform
         ? FTransform::Identity
-        : NodeInfo.AbsoluteTransform;
+        : NodeAbsoluteTransform;
 
     TArray<UObject*> CreatedObjects;
 
@@ -188,7 +290,7 @@ UObject* FglTFImporterEd::CreateNode(const TWeakPtr<FglTFImporterOptions>& InglT
             UE_LOG(LogglTFForUE4Ed, Error, TEXT("The mesh index is invalid!"));
         }
     }
-    if (glTFMeshPtr)
+    if (glTFMeshPtr && !InOutglTFImporterCollection.IsNodeMerged(glTFNodeId))
     {
         if (glTFImporterOptions->Details->bImportSkeletalMesh &&
             (glTFNodePtr->skin || (glTFImporterOptions->Details->bImportMorphTarget && !glTFMeshPtr->weights.empty())))
@@ -197,7 +299,14 @@ UObject* FglTFImporterEd::CreateNode(const TWeakPtr<FglTFImporterOptions>& InglT
                 ->CreateSkeletalMesh(InglTFImporterOptions, InGlTF, glTFNodeId, glTFNodePtr->mesh, glTFNodePtr->skin, InglTFBuffers, TransformMesh, InOutglTFImporterCollection);
             FglTFImporterEd::UpdateAssetImportData(NewSkeletalMesh, InglTFImporterOptions);
             CreatedObjects.Emplace(NewSkeletalMesh);
-            if (glTFImporterOptions->Details->bImportLevel)
+            if (glTFImporterOptions->Details->bImportLevel && glTFImporterOptions->Details->ShouldSpawnActorsInBatch())
+            {
+                FglTFImporterSpawnRequest SpawnRequest;
+                SpawnRequest.Transform = TransformActor;
+                SpawnRequest.SkeletalMesh = NewSkeletalMesh;
+                if (NewSkeletalMesh) InOutglTFImporterCollection.AddSpawnRequest(glTFNodeId, MoveTemp(SpawnRequest));
+            }
+            else if (glTFImporterOptions->Details->bImportLevel)
             {
                 SpawnSkeletalMeshActor(InOutglTFImporterCollection.TargetWorld, TransformActor, NewSkeletalMesh);
             }
@@ -208,9 +317,59 @@ UObject* FglTFImporterEd::CreateNode(const TWeakPtr<FglTFImporterOptions>& InglT
                 ->CreateStaticMesh(InglTFImporterOptions, InGlTF, glTFNodePtr->mesh, InglTFBuffers, TransformMesh, InOutglTFImporterCollection);
             FglTFImporterEd::UpdateAssetImportData(NewStaticMesh, InglTFImporterOptions);
             CreatedObjects.Emplace(NewStaticMesh);
-            if (glTFImporterOptions->Details->bImportLevel)
+            TArray<FTransform> InstanceTransforms;
+            if (glTFImporterOptions->Details->bImportLevel && NewStaticMesh
+                && GetNodeInstanceTransforms(InGlTF, glTFNodePtr, InglTFBuffers, InstanceTransforms))
+            {
+                /// the instances are relative to the node, and the mesh may be built with the node transform
+                const FTransform TransformMeshInverse = TransformMesh.Inverse();
+                for (FTransform& InstanceTransform : InstanceTransforms)
+                {
+                    InstanceTransform = TransformMeshInverse * InstanceTransform * TransformMesh;
+                }
+                if (glTFImporterOptions->Details->bInstanceRepeatedMeshes)
+                {
+                    for (FTransform& InstanceTransform : InstanceTransforms)
+                    {
+                        InstanceTransform *= TransformActor;
+                    }
+                    InOutglTFImporterCollection.AddStaticMeshInstances(*glTFNodePtr->mesh, InstanceTransforms);
+                }
+                else if (glTFImporterOptions->Details->ShouldSpawnActorsInBatch())
+                {
+                    FglTFImporterSpawnRequest SpawnRequest;
+                    SpawnRequest.Transform = TransformActor;
+                    SpawnRequest.StaticMesh = NewStaticMesh;
+                    SpawnRequest.InstanceTransforms = MoveTemp(InstanceTransforms);
+                    InOutglTFImporterCollection.AddSpawnRequest(glTFNodeId, MoveTemp(SpawnRequest));
+                }
+                else
+                {
+                    for (FTransform& InstanceTransform : InstanceTransforms)
+                    {
+                        InstanceTransform *= TransformActor;
+                    }
+                    SpawnInstancedStaticMeshActor(InOutglTFImporterCollection.TargetWorld, InstanceTransforms, NewStaticMesh);
+                }
+            }
+            else if (glTFImporterOptions->Details->bImportLevel && NewStaticMesh)
             {
-                SpawnStaticMeshActor(InOutglTFImporterCollection.TargetWorld, TransformActor, NewStaticMesh);
+                if (glTFImporterOptions->Details->bInstanceRepeatedMeshes)
+                {
+                    /// spawn them after all nodes are created, see `Create`
+                    InOutglTFImporterCollection.AddStaticMeshInstance(*glTFNodePtr->mesh, TransformActor);
+                }
+                else if (glTFImporterOptions->Details->ShouldSpawnActorsInBatch())
+                {
+                    FglTFImporterSpawnRequest SpawnRequest;
+                    SpawnRequest.Transform = TransformActor;
+                    SpawnRequest.StaticMesh = NewStaticMesh;
+                    InOutglTFImporterCollection.AddSpawnRequest(glTFNodeId, MoveTemp(SpawnRequest));
+                }
+                else
+                {
+                    SpawnStaticMeshActor(InOutglTFImporterCollection.TargetWorld, TransformActor, NewStaticMesh);
+                }
             }
         }
     }
@@ -246,6 +405,286 @@ UObject* FglTFImporterEd::CreateNode(const TWeakPtr<FglTFImporterOptions>& InglT
     return ((CreatedObjects.Num() > 0) ? CreatedObjects[0] : nullptr);
 }
 
+bool FglTFImporterEd::CreateStreamingLevels(const TWeakPtr<FglTFImporterOptions>& InglTFImporterOptions
+    , const FglTFImporterCollection& InglTFImporterCollection) const
+{
+    UWorld* PersistentWorld = InglTFImporterCollection.TargetWorld;
+    if (!PersistentWorld || !InputParent) return false;
+
+    const TSharedPtr<FglTFImporterOptions> glTFImporterOptions = InglTFImporterOptions.Pin();
+    check(glTFImporterOptions->Details);
+
+    const float CellSize = FMath::Max(glTFImporterOptions->Details->LevelGridCellSize, 1.0f);
+    const bool bCellsIn3D = glTFImporterOptions->Details->bLevelGridIn3D;
+    auto GetCellKey = [CellSize, bCellsIn3D](const FVector& InLocation) -> FIntVector
+    {
+        return FIntVector(FMath::FloorToInt(InLocation.X / CellSize)
+            , FMath::FloorToInt(InLocation.Y / CellSize)
+            , bCellsIn3D ? FMath::FloorToInt(InLocation.Z / CellSize) : 0);
+    };
+
+    struct FCell
+    {
+        TArray<FglTFImporterSpawnRequest> SpawnRequests;
+        /// maps the index of the request in the collection to the index in the cell
+        TMap<int32, int32> SpawnRequestIndices;
+        FBox Bounds;
+
+        FCell() : Bounds(ForceInitToZero) {}
+    };
+    TMap<FIntVector, FCell> Cells;
+
+    auto AddToCell = [&Cells](const FIntVector& InCellKey, int32 InSpawnRequestIndex, const FglTFImporterSpawnRequest& InSpawnRequest, const FBox& InBounds) -> FglTFImporterSpawnRequest&
+    {
+        FCell& Cell = Cells.FindOrAdd(InCellKey);
+        /// the actors are attached in the same cell only, the transforms are in the world space
+        const int32* ParentIndex = Cell.SpawnRequestIndices.Find(InSpawnRequest.ParentRequestIndex);
+        const int32 CellSpawnRequestIndex = Cell.SpawnRequests.Add(InSpawnRequest);
+        Cell.SpawnRequests[CellSpawnRequestIndex].ParentRequestIndex = ParentIndex ? *ParentIndex : INDEX_NONE;
+        Cell.SpawnRequestIndices.Add(InSpawnRequestIndex, CellSpawnRequestIndex);
+        Cell.Bounds += InBounds;
+        return Cell.SpawnRequests[CellSpawnRequestIndex];
+    };
+
+    /// the actor goes to the cell of its bounds' center, the instances are split by the cells
+    for (int32 i = 0; i < InglTFImporterCollection.SpawnRequests.Num(); ++i)
+    {
+        const FglTFImporterSpawnRequest& SpawnRequest = InglTFImporterCollection.SpawnRequests[i];
+        FBox MeshBounds(ForceInitToZero);
+        if (SpawnRequest.StaticMesh)
+        {
+            MeshBounds = SpawnRequest.StaticMesh->GetBounds().GetBox();
+        }
+        else if (SpawnRequest.SkeletalMesh)
+        {
+            MeshBounds = SpawnRequest.SkeletalMesh->GetBounds().GetBox();
+        }
+        else
+        {
+            continue;
+        }
+
+        if (SpawnRequest.InstanceTransforms.Num() <= 0)
+        {
+            const FBox Bounds = MeshBounds.TransformBy(SpawnRequest.Transform);
+            AddToCell(GetCellKey(Bounds.GetCenter()), i, SpawnRequest, Bounds);
+            continue;
+        }
+
+        TMap<FIntVector, TArray<FTransform>> CellInstanceTransforms;
+        TMap<FIntVector, FBox> CellInstanceBounds;
+        for (const FTransform& InstanceTransform : SpawnRequest.InstanceTransforms)
+        {
+            const FBox Bounds = MeshBounds.TransformBy(InstanceTransform * SpawnRequest.Transform);
+            const FIntVector CellKey = GetCellKey(Bounds.GetCenter());
+            CellInstanceTransforms.FindOrAdd(CellKey).Add(InstanceTransform);
+            if (FBox* InstanceBounds = CellInstanceBounds.Find(CellKey))
+            {
+                *InstanceBounds += Bounds;
+            }
+            else
+            {
+                CellInstanceBounds.Add(CellKey, Bounds);
+            }
+        }
+        for (TPair<FIntVector, TArray<FTransform>>& CellInstanceTransformsPair : CellInstanceTransforms)
+        {
+            FglTFImporterSpawnRequest CellSpawnRequest = SpawnRequest;
+            CellSpawnRequest.InstanceTransforms = MoveTemp(CellInstanceTransformsPair.Value);
+            AddToCell(CellInstanceTransformsPair.Key, i, CellSpawnRequest, CellInstanceBounds[CellInstanceTransformsPair.Key]);
+        }
+    }
+
+    /// like `CreateNewStreamingLevel`, each cell is saved and its temporary world destroyed before it is added to the persistent world
+    const FString PackageFolderPath = FPackageName::GetLongPackagePath(InputParent->GetPathName());
+    TArray<FIntVector> SavedCellKeys;
+    bool bDestroyedCellWorlds = false;
+    for (TPair<FIntVector, FCell>& CellPair : Cells)
+    {
+        const FIntVector& CellKey = CellPair.Key;
+        const FCell& Cell = CellPair.Value;
+
+        const FString CellName = FString::Printf(TEXT("%s_Cell_%d_%d_%d"), *InputName.ToString(), CellKey.X, CellKey.Y, CellKey.Z);
+        const FString CellPackageName = PackageFolderPath / CellName;
+
+        /// the world that spawns the actors, the persistent world if the cell is loaded in it
+        UWorld* CellWorld = nullptr;
+        ULevel* CellLevel = nullptr;
+        bool bTemporaryCellWorld = false;
+        UPackage* CellPackage = FindPackage(nullptr, *CellPackageName);
+        if (!CellPackage && FPackageName::DoesPackageExist(CellPackageName))
+        {
+            CellPackage = LoadPackage(nullptr, *CellPackageName, LOAD_None);
+            if (!CellPackage)
+            {
+                UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to load the exist package (%s) for the streaming level!"), *CellPackageName);
+                continue;
+            }
+        }
+        if (CellPackage)
+        {
+            /// reimport, the actors of the previous import are replaced
+            const ULevelStreaming* StreamingLevel = FLevelUtils::FindStreamingLevel(PersistentWorld, *CellPackageName);
+            if (StreamingLevel && StreamingLevel->GetLoadedLevel())
+            {
+                CellWorld = PersistentWorld;
+                CellLevel = StreamingLevel->GetLoadedLevel();
+            }
+            else
+            {
+                CellWorld = UWorld::FindWorldInPackage(CellPackage);
+                if (!CellWorld)
+                {
+                    UE_LOG(LogglTFForUE4Ed, Error, TEXT("The package (%s) exists already but is not a level, can't create the streaming level!"), *CellPackageName);
+                    continue;
+                }
+                if (!CellWorld->bIsWorldInitialized)
+                {
+                    CellWorld->WorldType = EWorldType::Inactive;
+                    CellWorld->InitWorld(UWorld::InitializationValues()
+                        .AllowAudioPlayback(false)
+                        .CreateNavigation(false)
+                        .CreateAISystem(false)
+                        .ShouldSimulatePhysics(false)
+                        .EnableTraceCollision(false));
+                    bTemporaryCellWorld = true;
+                }
+                CellLevel = CellWorld->PersistentLevel;
+            }
+
+            TArray<AActor*> OldActors;
+            for (AActor* Actor : CellLevel->Actors)
+            {
+                if (!Actor || Actor->IsA<AWorldSettings>() || Actor == CellLevel->GetDefaultBrush()) continue;
+                OldActors.Add(Actor);
+            }
+            for (AActor* OldActor : OldActors)
+            {
+                CellWorld->EditorDestroyActor(OldActor, true);
+            }
+            UE_LOG(LogglTFForUE4Ed, Display, TEXT("The streaming level (%s) exists already, replaced its %d actors"), *CellPackageName, OldActors.Num());
+        }
+        else
+        {
+#if (ENGINE_MINOR_VERSION <= 25)
+            CellPackage = CreatePackage(nullptr, *CellPackageName);
+#else
+            CellPackage = CreatePackage(*CellPackageName);
+#endif
+            if (!CellPackage)
+            {
+                UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to create the package (%s) for the streaming level!"), *CellPackageName);
+                continue;
+            }
+
+            CellWorld = UWorld::CreateWorld(EWorldType::Inactive, false, FName(*CellName), CellPackage, false);
+            if (!CellWorld)
+            {
+                UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to create the streaming level (%s)!"), *CellPackageName);
+                continue;
+            }
+            CellWorld->SetFlags(RF_Public | RF_Standalone);
+            FAssetRegistryModule::AssetCreated(CellWorld);
+            CellLevel = CellWorld->PersistentLevel;
+            bTemporaryCellWorld = true;
+        }
+        SpawnActors(CellWorld, Cell.SpawnRequests, CellLevel);
+        CellPackage->MarkPackageDirty();
+
+        /// the saving may collect the garbage, the temporary world is kept until it is destroyed
+        if (bTemporaryCellWorld)
+        {
+            CellWorld->AddToRoot();
+        }
+        const FString CellFilename = FPackageName::LongPackageNameToFilename(CellPackageName, FPackageName::GetMapPackageExtension());
+        const bool bCellSaved = FEditorFileUtils::SaveLevel(CellLevel, CellFilename);
+        if (bTemporaryCellWorld)
+        {
+            CellWorld->RemoveFromRoot();
+            CellWorld->DestroyWorld(false);
+            bDestroyedCellWorlds = true;
+        }
+        if (!bCellSaved)
+        {
+            UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to save the streaming level (%s)!"), *CellFilename);
+            continue;
+        }
+        SavedCellKeys.Add(CellKey);
+    }
+
+    /// the streaming levels load the cells from the disk, not the destroyed worlds
+    if (bDestroyedCellWorlds)
+    {
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    for (const FIntVector& CellKey : SavedCellKeys)
+    {
+        const FCell& Cell = Cells[CellKey];
+        const FString CellPackageName = PackageFolderPath / FString::Printf(TEXT("%s_Cell_%d_%d_%d"), *InputName.ToString(), CellKey.X, CellKey.Y, CellKey.Z);
+
+        /// the level was added to the persistent world by the previous import
+        if (FLevelUtils::FindStreamingLevel(PersistentWorld, *CellPackageName))
+        {
+            continue;
+        }
+
+        /// the cell is loaded when the camera is in the volume
+        FBox VolumeBounds = Cell.Bounds;
+        VolumeBounds.Min.X = CellKey.X * CellSize;
+        VolumeBounds.Min.Y = CellKey.Y * CellSize;
+        VolumeBounds.Max.X = VolumeBounds.Min.X + CellSize;
+        VolumeBounds.Max.Y = VolumeBounds.Min.Y + CellSize;
+        if (bCellsIn3D)
+        {
+            VolumeBounds.Min.Z = CellKey.Z * CellSize;
+            VolumeBounds.Max.Z = VolumeBounds.Min.Z + CellSize;
+        }
+        VolumeBounds = VolumeBounds.ExpandBy(glTFImporterOptions->Details->LevelGridStreamingDistance);
+
+        ALevelStreamingVolume* StreamingVolume = PersistentWorld->SpawnActor<ALevelStreamingVolume>(VolumeBounds.GetCenter(), FRotator::ZeroRotator);
+        if (StreamingVolume)
+        {
+            UCubeBuilder* CubeBuilder = NewObject<UCubeBuilder>();
+            CubeBuilder->X = VolumeBounds.GetSize().X;
+            CubeBuilder->Y = VolumeBounds.GetSize().Y;
+            CubeBuilder->Z = VolumeBounds.GetSize().Z;
+            UActorFactory::CreateBrushForVolumeActor(StreamingVolume, CubeBuilder);
+            StreamingVolume->StreamingLevelNames.Add(FName(*CellPackageName));
+        }
+
+#if ENGINE_MINOR_VERSION <= 20
+        UClass* StreamingLevelClass = ULevelStreamingKismet::StaticClass();
+#else
+        UClass* StreamingLevelClass = ULevelStreamingDynamic::StaticClass();
+#endif
+#if ENGINE_MINOR_VERSION <= 17
+        EditorLevelUtils::AddLevelToWorld(PersistentWorld, *CellPackageName, StreamingLevelClass);
+#else
+        UEditorLevelUtils::AddLevelToWorld(PersistentWorld, *CellPackageName, StreamingLevelClass);
+#endif
+        ULevelStreaming* StreamingLevel = FLevelUtils::FindStreamingLevel(PersistentWorld, *CellPackageName);
+        if (!StreamingLevel)
+        {
+            UE_LOG(LogglTFForUE4Ed, Error, TEXT("Failed to add the streaming level (%s) to the world!"), *CellPackageName);
+            if (StreamingVolume)
+            {
+                PersistentWorld->EditorDestroyActor(StreamingVolume, true);
+            }
+            continue;
+        }
+        StreamingLevel->LevelColor = FLinearColor::MakeRandomColor();
+        if (StreamingVolume)
+        {
+            StreamingLevel->EditorStreamingVolumes.Add(StreamingVolume);
+        }
+    }
+
+    PersistentWorld->MarkPackageDirty();
+    UE_LOG(LogglTFForUE4Ed, Display, TEXT("Partitioned %d spawn requests in %d streaming levels"), InglTFImporterCollection.SpawnRequests.Num(), Cells.Num());
+    return true;
+}
+
 bool FglTFImporterEd::SetAssetImportData(UObject* InObject, const FglTFImporterOptions& InglTFImporterOptions)
 {
     if (!InObject) return false;
@@ -30,6 +30,9 @@ private:
     UObject* CreateNode(const TWeakPtr<struct FglTFImporterOptions>& InglTFImporterOptions
         , const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SGlTFId>& InNodeIdPtr, const FglTFBuffers& InglTFBuffers
         , struct FglTFImporterCollection& InOutglTFImporterCollection) const;
+    /// spawn the requests in the streaming levels of the grid cells, the target world streams them by the volumes
+    bool CreateStreamingLevels(const TWeakPtr<struct FglTFImporterOptions>& InglTFImporterOptions
+        , const struct FglTFImporterCollection& InglTFImporterCollection) const;
 
 protected:
     class UFactory* InputFactory;
@@ -95,7 +95,7 @@ UAnimSequence* FglTFImporterEdAnimationSequence::CreateAnimationSequence(const T
         {
             for (FglTFAnimationSequenceKeyData& SequenceKeyData : SequenceData.KeyDatas)
             {
-                SequenceKeyData.Transform *= InOutglTFImporterCollection.FindNodeInfo(SequenceData.NodeIndex).RelativeTransform.Inverse();
+                SequenceKeyData.Transform *= InOutglTFImporterCollection.GetNodeRelativeTransform(SequenceData.NodeIndex).Inverse();
             }
         }
     }
@@ -114,7 +114,7 @@ UAnimSequence* FglTFImporterEdAnimationSequence::CreateAnimationSequence(const T
                 //WARN:
                 continue;
             }
-            if (!InOutglTFImporterCollection.NodeInfos.Contains(glTFAnimationSequenceData.NodeIndex))
+            if (!InOutglTFImporterCollection.HasNodeInfo(glTFAnimationSequenceData.NodeIndex))
             {
                 //WARN:
                 continue;
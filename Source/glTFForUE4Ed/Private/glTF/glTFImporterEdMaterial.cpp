@@ -63,9 +63,10 @@ UMaterialInterface* FglTFImporterEdMaterial::CreateMaterial(const TWeakPtr<FglTF
 {
     if (!InglTF) return nullptr;
     if (!InputParent) return nullptr;
-    if (InOutglTFImporterCollection.Materials.Contains(InMaterialId))
+    UMaterialInterface* ImportedMaterial = nullptr;
+    if (InOutglTFImporterCollection.FindMaterial(InMaterialId, ImportedMaterial))
     {
-        return InOutglTFImporterCollection.Materials[InMaterialId];
+        return ImportedMaterial;
     }
     if (InMaterialId < 0 || InMaterialId >= static_cast<int32>(InglTF->materials.size())) return nullptr;
 
@@ -538,7 +539,7 @@ UMaterialInterface* FglTFImporterEdMaterial::CreateMaterial(const TWeakPtr<FglTF
     NewMaterialInterface->PostEditChange();
     NewMaterialInterface->MarkPackageDirty();
 
-    InOutglTFImporterCollection.Materials.Add(InMaterialId, NewMaterialInterface);
+    InOutglTFImporterCollection.AddMaterial(InMaterialId, NewMaterialInterface);
     return NewMaterialInterface;
 }
 
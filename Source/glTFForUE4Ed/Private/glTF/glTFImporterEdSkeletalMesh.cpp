@@ -302,15 +302,13 @@ namespace glTFForUE4Ed
         const TArray<FVector>& InPoints,
         const TArray<FVector>& InNormals,
         const TArray<FVector4>& InTangents,
-        const TArray<FVector2D> InTextureCoords[MAX_TEXCOORDS],
-        const TArray<FVector4> InJointsIndeies[GLTF_JOINT_LAYERS_NUM_MAX],
-        const TArray<FVector4> InJointsWeights[GLTF_JOINT_LAYERS_NUM_MAX],
+        const FglTFMeshData& InMeshData,
         FSkeletalMeshImportData& InOutSkeletalMeshImportData)
     {
         if (InPoints.Num() <= 0) return false;
 
-        const TArray<FVector4>& JointIndeies0 = InJointsIndeies[0];
-        const TArray<FVector4>& JointWeights0 = InJointsWeights[0];
+        const TArray<FVector4>& JointIndeies0 = FglTFMeshData::Get(InMeshData.JointsIndices[0]);
+        const TArray<FVector4>& JointWeights0 = FglTFMeshData::Get(InMeshData.JointsWeights[0]);
         if (JointIndeies0.Num() == InPoints.Num() && JointWeights0.Num() == InPoints.Num())
         {
             for (int32 i = 0; i < InPoints.Num(); ++i)
@@ -393,7 +391,7 @@ namespace glTFForUE4Ed
                 {
                     Wedge.UVs[k] = FVector2D::ZeroVector;
 
-                    const TArray<FVector2D>& TextureCoord = InTextureCoords[k];
+                    const TArray<FVector2D>& TextureCoord = FglTFMeshData::Get(InMeshData.VertexTexcoords[k]);
                     if (PointIndex >= TextureCoord.Num()) continue;
                     Wedge.UVs[k] = TextureCoord[PointIndex];
                 }
@@ -418,7 +416,7 @@ namespace glTFForUE4Ed
         InOutSkeletalMeshImportData.NumTexCoords = 0;
         for (int32 i = 0; i < MAX_TEXCOORDS; ++i)
         {
-            const TArray<FVector2D>& TextureCoord = InTextureCoords[i];
+            const TArray<FVector2D>& TextureCoord = FglTFMeshData::Get(InMeshData.VertexTexcoords[i]);
             if (InPoints.Num() != TextureCoord.Num() && InTriangleIndices.Num() != TextureCoord.Num()) continue;
             ++InOutSkeletalMeshImportData.NumTexCoords;
         }
@@ -429,6 +427,29 @@ namespace glTFForUE4Ed
 
         return true;
     }
+
+    /// each morph target of the skeletal mesh import data is the whole mesh, not the deltas
+    template<typename TElem>
+    void BuildMorphTargets(const TArray<TSharedPtr<const TglTFSparseArray<TElem>, ESPMode::ThreadSafe>>& InMorphTargets, const TArray<TElem>& InOrigin, TArray<TArray<TElem>>& OutMorphTargets)
+    {
+        OutMorphTargets.SetNum(InMorphTargets.Num());
+        for (int32 i = 0; i < InMorphTargets.Num(); ++i)
+        {
+            TArray<TElem>& OutMorphTarget = OutMorphTargets[i];
+            if (!InMorphTargets[i].IsValid())
+            {
+                OutMorphTarget.Empty();
+                continue;
+            }
+            if (InMorphTargets[i]->Num() != InOrigin.Num())
+            {
+                InMorphTargets[i]->ToDense(OutMorphTarget);
+                continue;
+            }
+            OutMorphTarget = InOrigin;
+            InMorphTargets[i]->AddTo(OutMorphTarget, 1.0f);
+        }
+    }
 }
 
 TSharedPtr<FglTFImporterEdSkeletalMesh> FglTFImporterEdSkeletalMesh::Get(UFactory* InFactory, UObject* InParent, FName InName, EObjectFlags InFlags, FFeedbackContext* InFeedbackContext)
@@ -465,9 +486,10 @@ USkeletalMesh* FglTFImporterEdSkeletalMesh::CreateSkeletalMesh(
 
     const int32 glTFMeshId = *InMeshId;
     if (glTFMeshId < 0 || glTFMeshId >= static_cast<int32>(InGlTF->meshes.size())) return nullptr;
-    if (InOutglTFImporterCollection.SkeletalMeshes.Contains(glTFMeshId))
+    USkeletalMesh* ImportedSkeletalMesh = nullptr;
+    if (InOutglTFImporterCollection.FindSkeletalMesh(glTFMeshId, ImportedSkeletalMesh))
     {
-        return InOutglTFImporterCollection.SkeletalMeshes[glTFMeshId];
+        return ImportedSkeletalMesh;
     }
     const std::shared_ptr<libgltf::SMesh>& glTFMeshPtr = InGlTF->meshes[glTFMeshId];
 
@@ -799,7 +821,7 @@ USkeletalMesh* FglTFImporterEdSkeletalMesh::CreateSkeletalMesh(
         }
     }
 
-    InOutglTFImporterCollection.SkeletalMeshes.Add(glTFMeshId, SkeletalMesh);
+    InOutglTFImporterCollection.AddSkeletalMesh(glTFMeshId, SkeletalMesh);
     return SkeletalMesh;
 }
 
@@ -968,37 +990,30 @@ bool FglTFImporterEdSkeletalMesh::GenerateSkeletalMeshImportData(
         return false;
     }
 
-    TArray<uint32> TriangleIndices;
-    TArray<FVector> Points;
-    TArray<TArray<FVector>> MorphTargetsPoints;
-    TArray<FVector> Normals;
-    TArray<TArray<FVector>> MorphTargetsNormals;
-    TArray<FVector4> Tangents;
-    TArray<TArray<FVector4>> MorphTargetsTangents;
-    TArray<FVector2D> TextureCoords[MAX_TEXCOORDS];
-    TArray<FVector4> JointsIndeies[GLTF_JOINT_LAYERS_NUM_MAX];
-    TArray<FVector4> JointsWeights[GLTF_JOINT_LAYERS_NUM_MAX];
-    if (!FglTFImporter::GetSkeletalMeshData(InGlTF, InMeshPrimitive, InBuffers,
-        TriangleIndices,
-        Points, MorphTargetsPoints,
-        Normals, MorphTargetsNormals,
-        Tangents, MorphTargetsTangents,
-        TextureCoords,
-        JointsIndeies, JointsWeights))
+    /// the decoded attributes are only read, they are shared with the other primitives
+    FglTFMeshData MeshData;
+    if (!FglTFImporter::GetSkeletalMeshData(InGlTF, InMeshPrimitive, InBuffers, MeshData))
     {
         return false;
     }
+    const TArray<uint32>& TriangleIndices = FglTFMeshData::Get(MeshData.TriangleIndices);
+    const TArray<FVector>& Points = FglTFMeshData::Get(MeshData.VertexPositions);
+    const TArray<FVector>& Normals = FglTFMeshData::Get(MeshData.VertexNormals);
+    const TArray<FVector4>& Tangents = FglTFMeshData::Get(MeshData.VertexTangents);
 
     if (!glTFForUE4Ed::BuildSkeletalMeshImportData(TriangleIndices, Points, Normals, Tangents,
-        TextureCoords, JointsIndeies, JointsWeights, OutSkeletalMeshImportData))
+        MeshData, OutSkeletalMeshImportData))
     {
         return false;
     }
 
     /// ready for morph target
-    FglTFImporter::MergeMorphTarget<>(MorphTargetsPoints, Points, 1.0f);
-    FglTFImporter::MergeMorphTarget<>(MorphTargetsNormals, Normals, 1.0f);
-    FglTFImporter::MergeMorphTarget<>(MorphTargetsTangents, Tangents, 1.0f);
+    TArray<TArray<FVector>> MorphTargetsPoints;
+    TArray<TArray<FVector>> MorphTargetsNormals;
+    TArray<TArray<FVector4>> MorphTargetsTangents;
+    glTFForUE4Ed::BuildMorphTargets(MeshData.MorphTargetsVertexPositions, Points, MorphTargetsPoints);
+    glTFForUE4Ed::BuildMorphTargets(MeshData.MorphTargetsVertexNormals, Normals, MorphTargetsNormals);
+    glTFForUE4Ed::BuildMorphTargets(MeshData.MorphTargetsVertexTangents, Tangents, MorphTargetsTangents);
 
     /// build for morph target
     const int32 MeshWeightsCount = static_cast<int32>(InMesh->weights.size());
@@ -1011,7 +1026,7 @@ bool FglTFImporterEdSkeletalMesh::GenerateSkeletalMeshImportData(
         {
             if (glTFForUE4Ed::BuildSkeletalMeshImportData(TriangleIndices,
                 MorphTargetsPoints[i], MorphTargetsNormals[i], MorphTargetsTangents[i],
-                TextureCoords, JointsIndeies, JointsWeights, OutMorphTargetImportDatas[i]))
+                MeshData, OutMorphTargetImportDatas[i]))
             {
                 continue;
             }
@@ -1089,10 +1104,8 @@ bool FglTFImporterEdSkeletalMesh::GenerateSkeletalMeshImportData(const std::shar
         Bone.Flags = 0;
         Bone.NumChildren = static_cast<int32>(InGlTF->nodes[JointId]->children.size());
 
-        const FglTFImporterNodeInfo& NodeInfo = InOutglTFImporterCollection.FindNodeInfo(JointId);
-
         /// it is a root if the id is not contained in the joints
-        Bone.ParentIndex = NodeInfo.ParentIndex;
+        Bone.ParentIndex = InOutglTFImporterCollection.GetNodeParentIndex(JointId);
         if (!JointIds.Contains(Bone.ParentIndex))
         {
             Bone.ParentIndex = INDEX_NONE;
@@ -1101,7 +1114,7 @@ bool FglTFImporterEdSkeletalMesh::GenerateSkeletalMeshImportData(const std::shar
         }
         else
         {
-            Bone.BonePos.Transform = NodeInfo.RelativeTransform;
+            Bone.BonePos.Transform = InOutglTFImporterCollection.GetNodeRelativeTransform(JointId);
         }
 
         //TODO:
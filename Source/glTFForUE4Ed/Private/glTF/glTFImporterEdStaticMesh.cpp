@@ -8,6 +8,11 @@
 
 #include "RenderingThread.h"
 #include "RawMesh.h"
+#if ENGINE_MINOR_VERSION <= 23
+#else
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#endif
 #include "StaticMeshResources.h"
 #include "AssetRegistryModule.h"
 #include "Engine/StaticMesh.h"
@@ -18,10 +23,31 @@
 
 namespace glTFForUE4Ed
 {
+    /// append the wedge attributes and keep them aligned with the wedge indices, the missing ones on either side are filled by the default
+    template<typename TWedge>
+    void AppendWedges(const TArray<TWedge>& InFrom, int32 InFromWedgeCount, TArray<TWedge>& OutTo, int32 InToWedgeCount, const TWedge& InDefault)
+    {
+        if (InFrom.Num() <= 0 && OutTo.Num() <= 0) return;
+
+        OutTo.Reserve(InToWedgeCount + InFromWedgeCount);
+        while (OutTo.Num() < InToWedgeCount) OutTo.Add(InDefault);
+        if (InFrom.Num() == InFromWedgeCount)
+        {
+            OutTo.Append(InFrom);
+        }
+        else
+        {
+            while (OutTo.Num() < InToWedgeCount + InFromWedgeCount) OutTo.Add(InDefault);
+        }
+    }
+
     bool CheckAndMerge(const FRawMesh& InFrom, FRawMesh& OutTo)
     {
         if (InFrom.WedgeIndices.Num() <= 0 || InFrom.WedgeIndices.Num() % GLTF_TRIANGLE_POINTS_NUM) return false;
 
+        const int32 FromWedgeCount = InFrom.WedgeIndices.Num();
+        const int32 ToWedgeCount = OutTo.WedgeIndices.Num();
+
         OutTo.FaceMaterialIndices.Append(InFrom.FaceMaterialIndices);
         OutTo.FaceSmoothingMasks.Append(InFrom.FaceSmoothingMasks);
         int32 StartIndex = OutTo.VertexPositions.Num();
@@ -30,16 +56,42 @@ namespace glTFForUE4Ed
             OutTo.WedgeIndices.Add(WedgeIndex + StartIndex);
         }
         OutTo.VertexPositions.Append(InFrom.VertexPositions);
-        OutTo.WedgeTangentX.Append(InFrom.WedgeTangentX);
-        OutTo.WedgeTangentY.Append(InFrom.WedgeTangentY);
-        OutTo.WedgeTangentZ.Append(InFrom.WedgeTangentZ);
+        /// the same defaults as `GenerateRawMesh` uses for the missing tangents and normals
+        AppendWedges(InFrom.WedgeTangentX, FromWedgeCount, OutTo.WedgeTangentX, ToWedgeCount, FVector(0.0f, 0.0f, 1.0f));
+        AppendWedges(InFrom.WedgeTangentY, FromWedgeCount, OutTo.WedgeTangentY, ToWedgeCount, FVector(0.0f, 1.0f, 0.0f));
+        AppendWedges(InFrom.WedgeTangentZ, FromWedgeCount, OutTo.WedgeTangentZ, ToWedgeCount, FVector(1.0f, 0.0f, 0.0f));
         for (int32 i = 0; i < MAX_MESH_TEXTURE_COORDS; ++i)
         {
-            OutTo.WedgeTexCoords[i].Append(InFrom.WedgeTexCoords[i]);
+            AppendWedges(InFrom.WedgeTexCoords[i], FromWedgeCount, OutTo.WedgeTexCoords[i], ToWedgeCount, FVector2D::ZeroVector);
         }
-        OutTo.WedgeColors.Append(InFrom.WedgeColors);
+        AppendWedges(InFrom.WedgeColors, FromWedgeCount, OutTo.WedgeColors, ToWedgeCount, FColor::White);
         return true;
     }
+
+    /// does the same as `GenerateRawMesh` with the transform, the positions are transformed and the tangents are rotated
+    void TransformRawMesh(const FTransform& InTransform, FRawMesh& InOutRawMesh)
+    {
+        if (InTransform.Equals(FTransform::Identity)) return;
+
+        const FMatrix Matrix = InTransform.ToMatrixWithScale();
+        for (FVector& VertexPosition : InOutRawMesh.VertexPositions)
+        {
+            VertexPosition = Matrix.TransformPosition(VertexPosition);
+        }
+        const FQuat Rotation = InTransform.GetRotation();
+        for (FVector& WedgeTangentX : InOutRawMesh.WedgeTangentX)
+        {
+            WedgeTangentX = Rotation.RotateVector(WedgeTangentX);
+        }
+        for (FVector& WedgeTangentY : InOutRawMesh.WedgeTangentY)
+        {
+            WedgeTangentY = Rotation.RotateVector(WedgeTangentY);
+        }
+        for (FVector& WedgeTangentZ : InOutRawMesh.WedgeTangentZ)
+        {
+            WedgeTangentZ = Rotation.RotateVector(WedgeTangentZ);
+        }
+    }
 }
 
 TSharedPtr<FglTFImporterEdStaticMesh> FglTFImporterEdStaticMesh::Get(UFactory* InFactory, UObject* InParent, FName InName, EObjectFlags InFlags, FFeedbackContext* InFeedbackContext)
@@ -73,9 +125,10 @@ UStaticMesh* FglTFImporterEdStaticMesh::CreateStaticMesh(const TWeakPtr<FglTFImp
     const int32_t MeshId = *InMeshId;
 
     /// try to find the static mesh from the collection by the mesh id
-    if (InOutglTFImporterCollection.StaticMeshes.Contains(MeshId))
+    UStaticMesh* ImportedStaticMesh = nullptr;
+    if (InOutglTFImporterCollection.FindStaticMesh(MeshId, ImportedStaticMesh))
     {
-        return InOutglTFImporterCollection.StaticMeshes[MeshId];
+        return ImportedStaticMesh;
     }
     if (MeshId < 0 || MeshId >= static_cast<int32>(InGlTF->meshes.size()))
     {
@@ -105,22 +158,244 @@ UStaticMesh* FglTFImporterEdStaticMesh::CreateStaticMesh(const TWeakPtr<FglTFImp
     const FText TaskName = FText::Format(LOCTEXT("BeginImportAsStaticMeshTask", "Importing the glTF mesh ({0}) as a static mesh ({1})"), FText::AsNumber(MeshId), FText::FromString(StaticMeshName));
     glTFForUE4::FFeedbackTaskWrapper FeedbackTaskWrapper(FeedbackContext, TaskName, true);
 
-    FRawMesh NewRawMesh;
+    UStaticMesh* NewStaticMesh = nullptr;
     TArray<int32> glTFMaterialIds;
-    if (!GenerateRawMesh(glTFImporterOptions, InGlTF, MeshPtr, InBuffers
-        , InNodeAbsoluteTransform, NewRawMesh, glTFMaterialIds
-        , FeedbackTaskWrapper, InOutglTFImporterCollection))
+#if ENGINE_MINOR_VERSION <= 23
+    const bool bUseMeshDescription = false;
+#else
+    const bool bUseMeshDescription = glTFImporterOptions->Details->bUseMeshDescription;
+    if (bUseMeshDescription)
     {
-        checkSlow(0);
-        return nullptr;
+        FMeshDescription NewMeshDescription;
+        if (!GenerateMeshDescription(glTFImporterOptions, InGlTF, MeshPtr, InBuffers
+            , InNodeAbsoluteTransform, NewMeshDescription, glTFMaterialIds))
+        {
+            checkSlow(0);
+            return nullptr;
+        }
+        NewStaticMesh = BuildStaticMesh(InglTFImporterOptions, InGlTF, InBuffers, StaticMeshName
+            , nullptr, &NewMeshDescription, glTFMaterialIds
+            , FeedbackTaskWrapper, InOutglTFImporterCollection);
+    }
+#endif
+    if (!bUseMeshDescription)
+    {
+        FRawMesh NewRawMesh;
+        if (!GenerateRawMesh(glTFImporterOptions, InGlTF, MeshPtr, InBuffers
+            , InNodeAbsoluteTransform, NewRawMesh, glTFMaterialIds
+            , FeedbackTaskWrapper, InOutglTFImporterCollection))
+        {
+            checkSlow(0);
+            return nullptr;
+        }
+        NewStaticMesh = BuildStaticMesh(InglTFImporterOptions, InGlTF, InBuffers, StaticMeshName
+            , &NewRawMesh, nullptr, glTFMaterialIds
+            , FeedbackTaskWrapper, InOutglTFImporterCollection);
+    }
+    if (!NewStaticMesh) return nullptr;
+
+    /// update the collection
+    InOutglTFImporterCollection.AddStaticMesh(MeshId, NewStaticMesh);
+    return NewStaticMesh;
+}
+
+bool FglTFImporterEdStaticMesh::CreateMergedStaticMeshes(const TWeakPtr<FglTFImporterOptions>& InglTFImporterOptions
+    , const std::shared_ptr<libgltf::SGlTF>& InGlTF, const TArray<int32>& InRootNodeIds, const FglTFBuffers& InBuffers
+    , TArray<UStaticMesh*>& OutStaticMeshes, FglTFImporterCollection& InOutglTFImporterCollection) const
+{
+    if (!InGlTF)
+    {
+        checkfSlow(0, TEXT("The glTF data is invalid!"));
+        return false;
+    }
+    if (!InputParent || !InputName.IsValid())
+    {
+        checkfSlow(0, TEXT("The input class is invalid"));
+        return false;
+    }
+
+    const TSharedPtr<FglTFImporterOptions> glTFImporterOptions = InglTFImporterOptions.Pin();
+    check(glTFImporterOptions->Details);
+
+    const FText TaskName = FText::Format(LOCTEXT("BeginMergeStaticMeshesTask", "Merging the glTF meshes as the static meshes ({0})"), FText::FromName(InputName));
+    glTFForUE4::FFeedbackTaskWrapper FeedbackTaskWrapper(FeedbackContext, TaskName, true);
+
+    const int32 MaxTrianglesPerMergedMesh = FMath::Max(glTFImporterOptions->Details->MaxTrianglesPerMergedMesh, 1);
+    const FVector ScaleVector(glTFImporterOptions->Details->MeshScaleRatio);
+    const FTransform ScaleTransform(FQuat::Identity, FVector::ZeroVector, ScaleVector);
+
+    /// one section per material, the sections are merged in the order of their first use
+    TArray<int32> SectionglTFMaterialIds;
+    TArray<FRawMesh> SectionRawMeshes;
+    int32 TriangleCount = 0;
+
+    auto BuildMergedStaticMesh = [&]()
+    {
+        if (TriangleCount <= 0) return;
+
+        FRawMesh MergedRawMesh;
+        for (int32 i = 0; i < SectionRawMeshes.Num(); ++i)
+        {
+            FRawMesh& SectionRawMesh = SectionRawMeshes[i];
+            for (int32& FaceMaterialIndex : SectionRawMesh.FaceMaterialIndices)
+            {
+                FaceMaterialIndex = i;
+            }
+            glTFForUE4Ed::CheckAndMerge(SectionRawMesh, MergedRawMesh);
+        }
+
+        const FString StaticMeshName = FString::Printf(TEXT("SM_%s_Merged_%d"), *InputName.ToString(), OutStaticMeshes.Num());
+        UStaticMesh* NewStaticMesh = BuildStaticMesh(InglTFImporterOptions, InGlTF, InBuffers, StaticMeshName
+            , &MergedRawMesh, nullptr, SectionglTFMaterialIds
+            , FeedbackTaskWrapper, InOutglTFImporterCollection);
+        if (NewStaticMesh) OutStaticMeshes.Add(NewStaticMesh);
+
+        SectionglTFMaterialIds.Empty();
+        SectionRawMeshes.Empty();
+        TriangleCount = 0;
+    };
+
+    /// collect the static nodes under the roots in the depth first order
+    TArray<int32> MeshNodeIds;
+    TArray<int32> MeshNodeUseCounts;
+    MeshNodeUseCounts.SetNumZeroed(static_cast<int32>(InGlTF->meshes.size()));
+    TArray<int32> NodeIds(InRootNodeIds);
+    while (NodeIds.Num() > 0)
+    {
+        const int32 NodeId = NodeIds.Pop(false);
+        if (NodeId < 0 || NodeId >= static_cast<int32>(InGlTF->nodes.size())) continue;
+        const std::shared_ptr<libgltf::SNode>& NodePtr = InGlTF->nodes[NodeId];
+        if (!NodePtr) continue;
+        for (auto It = NodePtr->children.crbegin(); It != NodePtr->children.crend(); ++It)
+        {
+            if (*It) NodeIds.Add(**It);
+        }
+
+        if (!NodePtr->mesh) continue;
+        const int32 MeshId = *NodePtr->mesh;
+        if (MeshId < 0 || MeshId >= static_cast<int32>(InGlTF->meshes.size())) continue;
+        const std::shared_ptr<libgltf::SMesh>& MeshPtr = InGlTF->meshes[MeshId];
+        if (!MeshPtr) continue;
+
+        /// the skeletal meshes are imported by the node
+        if (glTFImporterOptions->Details->bImportSkeletalMesh &&
+            (NodePtr->skin || (glTFImporterOptions->Details->bImportMorphTarget && !MeshPtr->weights.empty())))
+        {
+            continue;
+        }
+        MeshNodeIds.Add(NodeId);
+        ++MeshNodeUseCounts[MeshId];
     }
 
-    const FString NewPackagePath = FPackageName::GetLongPackagePath(InputParent->GetPathName()) / StaticMeshName;
+    /// each glTF mesh is decoded once in its own space, and the copies are transformed for each node and instance,
+    /// the decoded mesh is released after its last node
+    struct FDecodedMesh
+    {
+        FDecodedMesh() : bDecoded(false), TriangleCount(0) {}
+
+        bool bDecoded;
+        TArray<FRawMesh> PrimitiveRawMeshes;
+        TArray<int32> PrimitiveglTFMaterialIds;
+        int32 TriangleCount;
+    };
+    TArray<FDecodedMesh> DecodedMeshes;
+    DecodedMeshes.SetNum(static_cast<int32>(InGlTF->meshes.size()));
+
+    TArray<FTransform> InstanceTransforms;
+    FRawMesh InstanceRawMesh;
+    for (const int32 NodeId : MeshNodeIds)
+    {
+        const std::shared_ptr<libgltf::SNode>& NodePtr = InGlTF->nodes[NodeId];
+        const int32 MeshId = *NodePtr->mesh;
+        const std::shared_ptr<libgltf::SMesh>& MeshPtr = InGlTF->meshes[MeshId];
+
+        FDecodedMesh& DecodedMesh = DecodedMeshes[MeshId];
+        if (!DecodedMesh.bDecoded)
+        {
+            DecodedMesh.bDecoded = true;
+            for (const std::shared_ptr<libgltf::SMeshPrimitive>& Primitive : MeshPtr->primitives)
+            {
+                FRawMesh& PrimitiveRawMesh = DecodedMesh.PrimitiveRawMeshes[DecodedMesh.PrimitiveRawMeshes.AddDefaulted()];
+                if (!Primitive || !GenerateRawMesh(glTFImporterOptions, InGlTF, MeshPtr, Primitive, InBuffers, FTransform::Identity, PrimitiveRawMesh, 0, FeedbackTaskWrapper, InOutglTFImporterCollection))
+                {
+                    DecodedMesh.PrimitiveRawMeshes.Pop(false);
+                    continue;
+                }
+                DecodedMesh.PrimitiveglTFMaterialIds.Add(Primitive->material ? static_cast<int32>(*Primitive->material) : INDEX_NONE);
+                DecodedMesh.TriangleCount += PrimitiveRawMesh.WedgeIndices.Num() / GLTF_TRIANGLE_POINTS_NUM;
+            }
+        }
+
+        /// the node without any geometry is left to `CreateNode`
+        if (DecodedMesh.TriangleCount > 0)
+        {
+            /// bake the transform that the actor of the node would have, and the instances of `EXT_mesh_gpu_instancing`
+            const FTransform& NodeAbsoluteTransform = InOutglTFImporterCollection.GetNodeAbsoluteTransform(NodeId);
+            const FTransform NodeTransform = glTFImporterOptions->Details->bApplyAbsoluteTransform
+                ? NodeAbsoluteTransform
+                : ScaleTransform * NodeAbsoluteTransform;
+            if (FglTFImporter::GetNodeInstanceTransforms(InGlTF, NodePtr, InBuffers, InstanceTransforms))
+            {
+                for (FTransform& InstanceTransform : InstanceTransforms)
+                {
+                    InstanceTransform *= NodeTransform;
+                }
+            }
+            else
+            {
+                InstanceTransforms.Init(NodeTransform, 1);
+            }
+
+            for (const FTransform& InstanceTransform : InstanceTransforms)
+            {
+                /// a mesh is never split, so a merged mesh may exceed the cap when it has one mesh only
+                if (TriangleCount > 0 && TriangleCount + DecodedMesh.TriangleCount > MaxTrianglesPerMergedMesh)
+                {
+                    BuildMergedStaticMesh();
+                }
+
+                for (int32 i = 0; i < DecodedMesh.PrimitiveRawMeshes.Num(); ++i)
+                {
+                    int32 SectionIndex = SectionglTFMaterialIds.Find(DecodedMesh.PrimitiveglTFMaterialIds[i]);
+                    if (SectionIndex == INDEX_NONE)
+                    {
+                        SectionIndex = SectionglTFMaterialIds.Add(DecodedMesh.PrimitiveglTFMaterialIds[i]);
+                        SectionRawMeshes.AddDefaulted();
+                    }
+                    InstanceRawMesh = DecodedMesh.PrimitiveRawMeshes[i];
+                    glTFForUE4Ed::TransformRawMesh(InstanceTransform, InstanceRawMesh);
+                    glTFForUE4Ed::CheckAndMerge(InstanceRawMesh, SectionRawMeshes[SectionIndex]);
+                }
+                TriangleCount += DecodedMesh.TriangleCount;
+            }
+
+            InOutglTFImporterCollection.SetNodeMerged(NodeId);
+        }
+
+        if (--MeshNodeUseCounts[MeshId] <= 0)
+        {
+            DecodedMesh = FDecodedMesh();
+            DecodedMesh.bDecoded = true;
+        }
+    }
+    BuildMergedStaticMesh();
+    return OutStaticMeshes.Num() > 0;
+}
+
+UStaticMesh* FglTFImporterEdStaticMesh::BuildStaticMesh(const TWeakPtr<FglTFImporterOptions>& InglTFImporterOptions
+    , const std::shared_ptr<libgltf::SGlTF>& InGlTF, const FglTFBuffers& InBuffers, const FString& InStaticMeshName
+    , FRawMesh* InOutRawMesh, FMeshDescription* InOutMeshDescription, const TArray<int32>& InglTFMaterialIds
+    , const glTFForUE4::FFeedbackTaskWrapper& InFeedbackTaskWrapper, FglTFImporterCollection& InOutglTFImporterCollection) const
+{
+    const TSharedPtr<FglTFImporterOptions> glTFImporterOptions = InglTFImporterOptions.Pin();
+    check(glTFImporterOptions->Details);
+
+    const FString NewPackagePath = FPackageName::GetLongPackagePath(InputParent->GetPathName()) / InStaticMeshName;
     UObject* NewAssetPackage = InputParent;
 
     /// load or create new static mesh
     bool bCreated = false;
-    UStaticMesh* NewStaticMesh = LoadObject<UStaticMesh>(NewAssetPackage, *StaticMeshName);
+    UStaticMesh* NewStaticMesh = LoadObject<UStaticMesh>(NewAssetPackage, *InStaticMeshName);
     if (!NewStaticMesh)
     {
         NewAssetPackage = LoadPackage(nullptr, *NewPackagePath, LOAD_None);
@@ -138,12 +413,12 @@ UStaticMesh* FglTFImporterEdStaticMesh::CreateStaticMesh(const TWeakPtr<FglTFImp
             //TODO: output error
             return nullptr;
         }
-        NewStaticMesh = LoadObject<UStaticMesh>(NewAssetPackage, *StaticMeshName);
+        NewStaticMesh = LoadObject<UStaticMesh>(NewAssetPackage, *InStaticMeshName);
     }
     if (!NewStaticMesh)
     {
         /// create new static mesh
-        NewStaticMesh = NewObject<UStaticMesh>(NewAssetPackage, UStaticMesh::StaticClass(), *StaticMeshName, InputFlags);
+        NewStaticMesh = NewObject<UStaticMesh>(NewAssetPackage, UStaticMesh::StaticClass(), *InStaticMeshName, InputFlags);
         checkSlow(NewStaticMesh);
         if (NewStaticMesh) FAssetRegistryModule::AssetCreated(NewStaticMesh);
         bCreated = true;
@@ -167,7 +442,14 @@ UStaticMesh* FglTFImporterEdStaticMesh::CreateStaticMesh(const TWeakPtr<FglTFImp
     NewStaticMesh->LightMapResolution = 64;
     NewStaticMesh->LightMapCoordinateIndex = 1;
 
-    if (!NewRawMesh.IsValidOrFixable())
+#if ENGINE_MINOR_VERSION <= 23
+    const bool bIsValidMesh = InOutRawMesh && InOutRawMesh->IsValidOrFixable();
+#else
+    const bool bIsValidMesh = InOutRawMesh
+        ? InOutRawMesh->IsValidOrFixable()
+        : (InOutMeshDescription && InOutMeshDescription->Polygons().Num() > 0);
+#endif
+    if (!bIsValidMesh)
     {
         // destroy new object
         if (bCreated)
@@ -178,31 +460,46 @@ UStaticMesh* FglTFImporterEdStaticMesh::CreateStaticMesh(const TWeakPtr<FglTFImp
         return NewStaticMesh;
     }
 
-    if (glTFImporterOptions->Details->bInvertNormal)
-    {
-        for (FVector& Normal : NewRawMesh.WedgeTangentZ)
-        {
-            Normal *= -1.0f;
-        }
-    }
-
-    SourceModel.BuildSettings.bRecomputeNormals = (glTFImporterOptions->Details->bRecomputeNormals || NewRawMesh.WedgeTangentZ.Num() != NewRawMesh.WedgeIndices.Num());
-    SourceModel.BuildSettings.bRecomputeTangents = (glTFImporterOptions->Details->bRecomputeTangents || NewRawMesh.WedgeTangentX.Num() != NewRawMesh.WedgeIndices.Num() || NewRawMesh.WedgeTangentY.Num() != NewRawMesh.WedgeIndices.Num());
     SourceModel.BuildSettings.bRemoveDegenerates = glTFImporterOptions->Details->bRemoveDegenerates;
     SourceModel.BuildSettings.bBuildAdjacencyBuffer = glTFImporterOptions->Details->bBuildAdjacencyBuffer;
     SourceModel.BuildSettings.bUseFullPrecisionUVs = glTFImporterOptions->Details->bUseFullPrecisionUVs;
     SourceModel.BuildSettings.bGenerateLightmapUVs = glTFImporterOptions->Details->bGenerateLightmapUVs;
-    SourceModel.RawMeshBulkData->SaveRawMesh(NewRawMesh);
+    if (InOutRawMesh)
+    {
+        if (glTFImporterOptions->Details->bInvertNormal)
+        {
+            for (FVector& Normal : InOutRawMesh->WedgeTangentZ)
+            {
+                Normal *= -1.0f;
+            }
+        }
+
+        SourceModel.BuildSettings.bRecomputeNormals = (glTFImporterOptions->Details->bRecomputeNormals || InOutRawMesh->WedgeTangentZ.Num() != InOutRawMesh->WedgeIndices.Num());
+        SourceModel.BuildSettings.bRecomputeTangents = (glTFImporterOptions->Details->bRecomputeTangents || InOutRawMesh->WedgeTangentX.Num() != InOutRawMesh->WedgeIndices.Num() || InOutRawMesh->WedgeTangentY.Num() != InOutRawMesh->WedgeIndices.Num());
+        SourceModel.RawMeshBulkData->SaveRawMesh(*InOutRawMesh);
+    }
+#if ENGINE_MINOR_VERSION <= 23
+#else
+    else
+    {
+        /// the zero normals and tangents are computed by the builder, the normals are inverted in `GenerateMeshDescription`
+        SourceModel.BuildSettings.bRecomputeNormals = glTFImporterOptions->Details->bRecomputeNormals;
+        SourceModel.BuildSettings.bRecomputeTangents = glTFImporterOptions->Details->bRecomputeTangents;
+        FMeshDescription* NewMeshDescription = NewStaticMesh->CreateMeshDescription(0);
+        *NewMeshDescription = MoveTemp(*InOutMeshDescription);
+        NewStaticMesh->CommitMeshDescription(0);
+    }
+#endif
 
     /// Build the static mesh
     TArray<FText> BuildErrors;
     NewStaticMesh->Build(false, &BuildErrors);
     if (BuildErrors.Num() > 0)
     {
-        FeedbackTaskWrapper.Log(ELogVerbosity::Warning, LOCTEXT("StaticMeshBuildHasError", "Failed to build the static mesh!"));
+        InFeedbackTaskWrapper.Log(ELogVerbosity::Warning, LOCTEXT("StaticMeshBuildHasError", "Failed to build the static mesh!"));
         for (const FText& BuildError : BuildErrors)
         {
-            FeedbackTaskWrapper.Log(ELogVerbosity::Warning, BuildError);
+            InFeedbackTaskWrapper.Log(ELogVerbosity::Warning, BuildError);
         }
     }
 
@@ -222,14 +519,14 @@ UStaticMesh* FglTFImporterEdStaticMesh::CreateStaticMesh(const TWeakPtr<FglTFImp
     TSharedPtr<FglTFImporterEdMaterial> glTFImporterEdMaterial = FglTFImporterEdMaterial::Get(InputFactory, InputParent, InputName, InputFlags, FeedbackContext);
     FMeshSectionInfoMap NewMap;
     static UMaterial* DefaultMaterial = UMaterial::GetDefaultMaterial(MD_Surface);
-    for (int32 i = 0; i < glTFMaterialIds.Num(); ++i)
+    for (int32 i = 0; i < InglTFMaterialIds.Num(); ++i)
     {
-        const int32& glTFMaterialId = glTFMaterialIds[i];
+        const int32& glTFMaterialId = InglTFMaterialIds[i];
         UMaterialInterface* NewMaterial = nullptr;
         if (glTFImporterOptions->Details->bImportMaterial)
         {
             NewMaterial = glTFImporterEdMaterial->CreateMaterial(InglTFImporterOptions
-                , InGlTF, glTFMaterialId, InBuffers, FeedbackTaskWrapper
+                , InGlTF, glTFMaterialId, InBuffers, InFeedbackTaskWrapper
                 , InOutglTFImporterCollection);
         }
         if (!NewMaterial)
@@ -248,9 +545,6 @@ UStaticMesh* FglTFImporterEdStaticMesh::CreateStaticMesh(const TWeakPtr<FglTFImp
     }
     StaticMeshSectionInfoMap.Clear();
     StaticMeshSectionInfoMap.CopyFrom(NewMap);
-
-    /// update the collection
-    InOutglTFImporterCollection.StaticMeshes.Add(MeshId, NewStaticMesh);
     return NewStaticMesh;
 }
 
@@ -306,105 +600,169 @@ bool FglTFImporterEdStaticMesh::GenerateRawMesh(const TSharedPtr<FglTFImporterOp
         return false;
     }
 
-    TArray<uint32> TriangleIndices;
-    TArray<FVector> Points;
-    TArray<TArray<FVector>> MorphTargetsPoints;
-    TArray<FVector> Normals;
-    TArray<TArray<FVector>> MorphTargetsNormals;
-    TArray<FVector4> Tangents;
-    TArray<TArray<FVector4>> MorphTargetsTangents;
-    TArray<FVector2D> TextureCoords[MAX_MESH_TEXTURE_COORDS];
-    if (!FglTFImporter::GetStaticMeshData(InGlTF, InMeshPrimitive, InBuffers,
-        TriangleIndices,
-        Points, MorphTargetsPoints,
-        Normals, MorphTargetsNormals,
-        Tangents, MorphTargetsTangents,
-        TextureCoords))
+    FglTFMeshData MeshData;
+    if (!FglTFImporter::GetStaticMeshData(InGlTF, InMeshPrimitive, InBuffers, MeshData))
     {
         return false;
     }
 
-    if (Points.Num() <= 0) return false;
+    const TArray<uint32>& TriangleIndices = FglTFMeshData::Get(MeshData.TriangleIndices);
+    const int32 PointsNum = FglTFMeshData::Get(MeshData.VertexPositions).Num();
+    if (PointsNum <= 0) return false;
 
     OutRawMesh.Empty();
 
     OutRawMesh.WedgeIndices.Append(TriangleIndices);
 
-    if (InglTFImporterOptions->Details->bImportMorphTarget)
+    /// the decoded attributes may be shared by the other primitives, they are only copied where they are changed
+    const bool bMergeMorphTarget = InglTFImporterOptions->Details->bImportMorphTarget;
+    const bool bMergePoints = bMergeMorphTarget && FglTFImporter::HasMorphTargetWeights(MeshData.MorphTargetsVertexPositions, InMesh->weights);
+    const bool bMergeNormals = bMergeMorphTarget && FglTFImporter::HasMorphTargetWeights(MeshData.MorphTargetsVertexNormals, InMesh->weights);
+    const bool bMergeTangents = bMergeMorphTarget && FglTFImporter::HasMorphTargetWeights(MeshData.MorphTargetsVertexTangents, InMesh->weights);
+    const bool bNodeAbsoluteTransformIsIdentity = InNodeAbsoluteTransform.Equals(FTransform::Identity);
+    /// the node's scale is the dequantization of the quantized positions, it is folded in one matrix with the rotation and translation
+    const FMatrix NodeAbsoluteMatrix = InNodeAbsoluteTransform.ToMatrixWithScale();
+    const FQuat NodeAbsoluteRotation = InNodeAbsoluteTransform.GetRotation();
+
+    if (bMergePoints || bNodeAbsoluteTransformIsIdentity)
     {
-        /// merge with the morph target
-        FglTFImporter::MergeMorphTarget<FVector>(Points, MorphTargetsPoints, InMesh->weights);
-        FglTFImporter::MergeMorphTarget<FVector>(Normals, MorphTargetsNormals, InMesh->weights);
-        FglTFImporter::MergeMorphTarget<FVector4>(Tangents, MorphTargetsTangents, InMesh->weights);
+        /// the raw mesh owns the positions, they are moved to it if no other primitive shares them
+        FglTFMeshData::MoveOrCopy(MeshData.VertexPositions, OutRawMesh.VertexPositions);
+        if (bMergePoints)
+        {
+            /// merge with the morph target
+            FglTFImporter::MergeMorphTarget<FVector>(OutRawMesh.VertexPositions, MeshData.MorphTargetsVertexPositions, InMesh->weights);
+        }
+        if (!bNodeAbsoluteTransformIsIdentity)
+        {
+            for (FVector& Point : OutRawMesh.VertexPositions)
+            {
+                Point = NodeAbsoluteMatrix.TransformPosition(Point);
+            }
+        }
     }
-
-    const bool bNodeAbsoluteTransformIsIdentity = InNodeAbsoluteTransform.Equals(FTransform::Identity);
-    if (!bNodeAbsoluteTransformIsIdentity)
+    else
     {
-        for (FVector& Point : Points)
+        /// transform from the decoded positions to the raw mesh directly
+        const TArray<FVector>& Points = FglTFMeshData::Get(MeshData.VertexPositions);
+        OutRawMesh.VertexPositions.SetNumUninitialized(PointsNum);
+        for (int32 i = 0; i < PointsNum; ++i)
         {
-            Point = InNodeAbsoluteTransform.TransformPosition(Point);
+            OutRawMesh.VertexPositions[i] = NodeAbsoluteMatrix.TransformPosition(Points[i]);
         }
+        MeshData.VertexPositions.Reset();
     }
-    OutRawMesh.VertexPositions.Append(Points);
 
-    if (Normals.Num() == Points.Num())
+    TArray<FVector> OwnedNormals;
+    const TArray<FVector>* Normals = &FglTFMeshData::Get(MeshData.VertexNormals);
+    if (bMergeNormals)
     {
-        if (!bNodeAbsoluteTransformIsIdentity)
+        FglTFMeshData::MoveOrCopy(MeshData.VertexNormals, OwnedNormals);
+        FglTFImporter::MergeMorphTarget<FVector>(OwnedNormals, MeshData.MorphTargetsVertexNormals, InMesh->weights);
+        Normals = &OwnedNormals;
+    }
+    if (Normals->Num() != PointsNum)
+    {
+        OwnedNormals.Init(FVector(1.0f, 0.0f, 0.0f), PointsNum);
+        Normals = &OwnedNormals;
+    }
+    else if (!bNodeAbsoluteTransformIsIdentity)
+    {
+        if (Normals == &OwnedNormals)
         {
-            for (FVector& Normal : Normals)
+            for (FVector& Normal : OwnedNormals)
             {
-                Normal = InNodeAbsoluteTransform.GetRotation().RotateVector(Normal);
+                Normal = NodeAbsoluteRotation.RotateVector(Normal);
             }
         }
+        else
+        {
+            OwnedNormals.SetNumUninitialized(PointsNum);
+            for (int32 i = 0; i < PointsNum; ++i)
+            {
+                OwnedNormals[i] = NodeAbsoluteRotation.RotateVector((*Normals)[i]);
+            }
+            Normals = &OwnedNormals;
+        }
     }
-    else
+
+    TArray<FVector4> OwnedTangents;
+    const TArray<FVector4>* Tangents = &FglTFMeshData::Get(MeshData.VertexTangents);
+    if (bMergeTangents)
     {
-        Normals.Init(FVector(1.0f, 0.0f, 0.0f), Points.Num());
+        FglTFMeshData::MoveOrCopy(MeshData.VertexTangents, OwnedTangents);
+        FglTFImporter::MergeMorphTarget<FVector4>(OwnedTangents, MeshData.MorphTargetsVertexTangents, InMesh->weights);
+        Tangents = &OwnedTangents;
     }
 
     TArray<FVector> WedgeTangentXs;
     TArray<FVector> WedgeTangentYs;
-    if (Tangents.Num() == Points.Num())
+    if (Tangents->Num() == PointsNum)
     {
-        for (int32 i = 0; i < Tangents.Num(); ++i)
+        WedgeTangentXs.Reserve(PointsNum);
+        WedgeTangentYs.Reserve(PointsNum);
+        for (int32 i = 0; i < PointsNum; ++i)
         {
-            const FVector4& Tangent = Tangents[i];
+            const FVector4& Tangent = (*Tangents)[i];
 
             FVector WedgeTangentX(Tangent.X, Tangent.Y, Tangent.Z);
             if (!bNodeAbsoluteTransformIsIdentity)
             {
-                WedgeTangentX = InNodeAbsoluteTransform.GetRotation().RotateVector(WedgeTangentX);
+                WedgeTangentX = NodeAbsoluteRotation.RotateVector(WedgeTangentX);
             }
             WedgeTangentXs.Add(WedgeTangentX);
 
-            const FVector& Normal = Normals[i];
+            const FVector& Normal = (*Normals)[i];
             WedgeTangentYs.Add(FVector::CrossProduct(Normal, WedgeTangentX * Tangent.W));
         }
     }
     else
     {
         UE_LOG(LogglTFForUE4Ed, Warning, TEXT("Why is the number of tangent not equal with the number of normal?"));
-        WedgeTangentXs.Init(FVector(0.0f, 0.0f, 1.0f), Normals.Num());
-        WedgeTangentYs.Init(FVector(0.0f, 1.0f, 0.0f), Normals.Num());
+        WedgeTangentXs.Init(FVector(0.0f, 0.0f, 1.0f), PointsNum);
+        WedgeTangentYs.Init(FVector(0.0f, 1.0f, 0.0f), PointsNum);
     }
 
     for (int32 i = 0; i < TriangleIndices.Num(); ++i)
     {
         OutRawMesh.WedgeTangentX.Add(WedgeTangentXs[TriangleIndices[i]]);
         OutRawMesh.WedgeTangentY.Add(WedgeTangentYs[TriangleIndices[i]]);
-        OutRawMesh.WedgeTangentZ.Add(Normals[TriangleIndices[i]]);
+        OutRawMesh.WedgeTangentZ.Add((*Normals)[TriangleIndices[i]]);
     }
 
     int32 WedgeIndicesCount = OutRawMesh.WedgeIndices.Num();
-    if (TextureCoords[0].Num() <= 0)
+    for (int32 i = 0; i < MAX_TEXCOORDS; ++i)
     {
-        TextureCoords[0].Init(FVector2D::ZeroVector, WedgeIndicesCount);
-    }
-    for (int32 i = 0; i < MAX_MESH_TEXTURE_COORDS; ++i)
-    {
-        if (TextureCoords[i].Num() <= 0) continue;
-        OutRawMesh.WedgeTexCoords[i].Append(TextureCoords[i]);
+        const TArray<FVector2D>& TextureCoord = FglTFMeshData::Get(MeshData.VertexTexcoords[i]);
+        if (TextureCoord.Num() <= 0)
+        {
+            if (i == 0)
+            {
+                OutRawMesh.WedgeTexCoords[i].Init(FVector2D::ZeroVector, WedgeIndicesCount);
+            }
+            continue;
+        }
+
+        TArray<FVector2D>& WedgeTexCoords = OutRawMesh.WedgeTexCoords[i];
+        if (TextureCoord.Num() == WedgeIndicesCount)
+        {
+            FglTFMeshData::MoveOrCopy(MeshData.VertexTexcoords[i], WedgeTexCoords);
+        }
+        else if (TextureCoord.Num() == PointsNum)
+        {
+            /// expand to the wedges directly
+            WedgeTexCoords.SetNumUninitialized(WedgeIndicesCount);
+            for (int32 j = 0; j < WedgeIndicesCount; ++j)
+            {
+                WedgeTexCoords[j] = TextureCoord[OutRawMesh.WedgeIndices[j] % TextureCoord.Num()];
+            }
+            MeshData.VertexTexcoords[i].Reset();
+        }
+        else
+        {
+            //HACK: the incomplete texcoords data
+            WedgeTexCoords.SetNumZeroed(WedgeIndicesCount);
+        }
     }
 
     if (WedgeIndicesCount > 0 && (WedgeIndicesCount % GLTF_TRIANGLE_POINTS_NUM) == 0)
@@ -418,31 +776,218 @@ bool FglTFImporterEdStaticMesh::GenerateRawMesh(const TSharedPtr<FglTFImporterOp
         {
             OutRawMesh.FaceSmoothingMasks.Init(1, TriangleCount);
         }
-        for (int32 i = 0; i < MAX_MESH_TEXTURE_COORDS; ++i)
+    }
+    return OutRawMesh.IsValidOrFixable();
+}
+
+#if ENGINE_MINOR_VERSION <= 23
+#else
+bool FglTFImporterEdStaticMesh::GenerateMeshDescription(const TSharedPtr<FglTFImporterOptions> InglTFImporterOptions,
+    const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+    const std::shared_ptr<libgltf::SMesh>& InMesh,
+    const FglTFBuffers& InBuffers,
+    const FTransform& InNodeAbsoluteTransform,
+    FMeshDescription& OutMeshDescription, TArray<int32>& InOutglTFMaterialIds) const
+{
+    checkSlow(InglTFImporterOptions.IsValid());
+    if (!InMesh || !InglTFImporterOptions.IsValid()) return false;
+
+    auto GetAccessorCount = [&InGlTF](const std::shared_ptr<libgltf::SGlTFId>& InAccessorId) -> int32
+    {
+        if (!InAccessorId) return 0;
+        const int32 AccessorIndex = static_cast<int32>(*InAccessorId);
+        if (AccessorIndex < 0 || AccessorIndex >= static_cast<int32>(InGlTF->accessors.size()) || !InGlTF->accessors[AccessorIndex]) return 0;
+        return FMath::Max(InGlTF->accessors[AccessorIndex]->count, 0);
+    };
+    auto GetAttributeCount = [&GetAccessorCount](const std::shared_ptr<libgltf::SMeshPrimitive>& InPrimitive, const TCHAR* InAttributeName) -> int32
+    {
+        const libgltf::string_t attribute_name = GLTF_TCHAR_TO_GLTFSTRING(InAttributeName);
+        const auto AttributeCIt = InPrimitive->attributes.find(attribute_name);
+        return AttributeCIt != InPrimitive->attributes.cend() ? GetAccessorCount(AttributeCIt->second) : 0;
+    };
+
+    /// reserve the mesh description by the accessors' counts, the primitives are decoded one by one
+    int32 PrimitiveCount = 0;
+    int32 VertexCount = 0;
+    int32 TriangleCount = 0;
+    int32 TexCoordCount = 1;
+    for (const std::shared_ptr<libgltf::SMeshPrimitive>& Primitive : InMesh->primitives)
+    {
+        if (!Primitive) continue;
+        const int32 PointsNum = GetAttributeCount(Primitive, TEXT("POSITION"));
+        const int32 WedgeIndicesCount = Primitive->indices ? GetAccessorCount(Primitive->indices) : PointsNum;
+        for (int32 i = 0; i < MAX_TEXCOORDS; ++i)
+        {
+            if (GetAttributeCount(Primitive, *FString::Printf(TEXT("TEXCOORD_%d"), i)) <= 0) continue;
+            TexCoordCount = FMath::Max(TexCoordCount, i + 1);
+        }
+        VertexCount += PointsNum;
+        TriangleCount += WedgeIndicesCount / GLTF_TRIANGLE_POINTS_NUM;
+        ++PrimitiveCount;
+    }
+    if (PrimitiveCount <= 0) return false;
+
+    FStaticMeshAttributes StaticMeshAttributes(OutMeshDescription);
+    StaticMeshAttributes.Register();
+    TVertexAttributesRef<FVector> VertexPositions = StaticMeshAttributes.GetVertexPositions();
+    TVertexInstanceAttributesRef<FVector> VertexInstanceNormals = StaticMeshAttributes.GetVertexInstanceNormals();
+    TVertexInstanceAttributesRef<FVector> VertexInstanceTangents = StaticMeshAttributes.GetVertexInstanceTangents();
+    TVertexInstanceAttributesRef<float> VertexInstanceBinormalSigns = StaticMeshAttributes.GetVertexInstanceBinormalSigns();
+    TVertexInstanceAttributesRef<FVector2D> VertexInstanceUVs = StaticMeshAttributes.GetVertexInstanceUVs();
+    TPolygonGroupAttributesRef<FName> PolygonGroupImportedMaterialSlotNames = StaticMeshAttributes.GetPolygonGroupMaterialSlotNames();
+    VertexInstanceUVs.SetNumIndices(TexCoordCount);
+
+    /// the vertex instances are shared per vertex, the texcoords per wedge grow them
+    OutMeshDescription.ReserveNewVertices(VertexCount);
+    OutMeshDescription.ReserveNewVertexInstances(VertexCount);
+    OutMeshDescription.ReserveNewPolygons(TriangleCount);
+    OutMeshDescription.ReserveNewEdges(TriangleCount * GLTF_TRIANGLE_POINTS_NUM);
+    OutMeshDescription.ReserveNewPolygonGroups(PrimitiveCount);
+
+    const bool bNodeAbsoluteTransformIsIdentity = InNodeAbsoluteTransform.Equals(FTransform::Identity);
+    /// the node's scale is the dequantization of the quantized positions, it is folded in one matrix with the rotation and translation
+    const FMatrix NodeAbsoluteMatrix = InNodeAbsoluteTransform.ToMatrixWithScale();
+    const FQuat NodeAbsoluteRotation = InNodeAbsoluteTransform.GetRotation();
+    const float NormalSign = InglTFImporterOptions->Details->bInvertNormal ? -1.0f : 1.0f;
+
+    TArray<FVector> MergedPoints;
+    TArray<FVector> MergedNormals;
+    TArray<FVector4> MergedTangents;
+    TArray<FVertexID> VertexIDs;
+    TArray<FVertexInstanceID> VertexInstanceIDs;
+    TArray<FVertexInstanceID> TriangleVertexInstanceIDs;
+    TriangleVertexInstanceIDs.SetNum(GLTF_TRIANGLE_POINTS_NUM);
+    for (int32 PrimitiveIndex = 0; PrimitiveIndex < static_cast<int32>(InMesh->primitives.size()); ++PrimitiveIndex)
+    {
+        const std::shared_ptr<libgltf::SMeshPrimitive>& Primitive = InMesh->primitives[PrimitiveIndex];
+        if (!Primitive) continue;
+
+        FglTFMeshData MeshData;
+        if (!FglTFImporter::GetStaticMeshData(InGlTF, Primitive, InBuffers, MeshData))
+        {
+            checkSlow(0);
+            continue;
+        }
+        const TArray<uint32>& TriangleIndices = FglTFMeshData::Get(MeshData.TriangleIndices);
+        const TArray<FVector>* Points = &FglTFMeshData::Get(MeshData.VertexPositions);
+        const TArray<FVector>* Normals = &FglTFMeshData::Get(MeshData.VertexNormals);
+        const TArray<FVector4>* Tangents = &FglTFMeshData::Get(MeshData.VertexTangents);
+        const int32 PointsNum = Points->Num();
+        const int32 WedgeIndicesCount = TriangleIndices.Num();
+        if (PointsNum <= 0 || WedgeIndicesCount <= 0 || (WedgeIndicesCount % GLTF_TRIANGLE_POINTS_NUM) != 0) continue;
+
+        /// the triangles index the vertex ids directly
+        bool bIndicesValid = true;
+        for (const uint32 TriangleIndex : TriangleIndices)
+        {
+            if (TriangleIndex >= static_cast<uint32>(PointsNum))
+            {
+                bIndicesValid = false;
+                break;
+            }
+        }
+        if (!bIndicesValid)
         {
-            if (OutRawMesh.WedgeTexCoords[i].Num() <= 0) continue;
+            UE_LOG(LogglTFForUE4Ed, Warning, TEXT("The primitive(%d) of the mesh has the index out of the %d vertices, skip it!"), PrimitiveIndex, PointsNum);
+            continue;
+        }
 
-            //HACK: calculate the incomplete texcoords data
-            if (OutRawMesh.WedgeTexCoords[i].Num() == WedgeIndicesCount)
+        if (InglTFImporterOptions->Details->bImportMorphTarget)
+        {
+            /// merge with the morph target, the decoded attributes may be shared so only the merged ones are copied
+            if (FglTFImporter::HasMorphTargetWeights(MeshData.MorphTargetsVertexPositions, InMesh->weights))
+            {
+                FglTFMeshData::MoveOrCopy(MeshData.VertexPositions, MergedPoints);
+                FglTFImporter::MergeMorphTarget<FVector>(MergedPoints, MeshData.MorphTargetsVertexPositions, InMesh->weights);
+                Points = &MergedPoints;
+            }
+            if (FglTFImporter::HasMorphTargetWeights(MeshData.MorphTargetsVertexNormals, InMesh->weights))
             {
-                //
+                FglTFMeshData::MoveOrCopy(MeshData.VertexNormals, MergedNormals);
+                FglTFImporter::MergeMorphTarget<FVector>(MergedNormals, MeshData.MorphTargetsVertexNormals, InMesh->weights);
+                Normals = &MergedNormals;
             }
-            else if (OutRawMesh.WedgeTexCoords[i].Num() == OutRawMesh.VertexPositions.Num())
+            if (FglTFImporter::HasMorphTargetWeights(MeshData.MorphTargetsVertexTangents, InMesh->weights))
             {
-                TArray<FVector2D> WedgeTexCoords = OutRawMesh.WedgeTexCoords[i];
-                OutRawMesh.WedgeTexCoords[i].SetNumUninitialized(WedgeIndicesCount);
-                for (int32 j = 0; j < OutRawMesh.WedgeIndices.Num(); ++j)
+                FglTFMeshData::MoveOrCopy(MeshData.VertexTangents, MergedTangents);
+                FglTFImporter::MergeMorphTarget<FVector4>(MergedTangents, MeshData.MorphTargetsVertexTangents, InMesh->weights);
+                Tangents = &MergedTangents;
+            }
+        }
+
+        const bool bHasNormals = (Normals->Num() == PointsNum);
+        const bool bHasTangents = bHasNormals && (Tangents->Num() == PointsNum);
+        /// the texcoords per wedge (some of the draco meshes) need the vertex instances per wedge
+        bool bTexCoordsPerWedge = false;
+        for (int32 i = 0; i < TexCoordCount; ++i)
+        {
+            const int32 TextureCoordNum = FglTFMeshData::Get(MeshData.VertexTexcoords[i]).Num();
+            bTexCoordsPerWedge |= (TextureCoordNum > 0 && TextureCoordNum != PointsNum && TextureCoordNum == WedgeIndicesCount);
+        }
+
+        /// the section index is the index of the polygon group, the slot name doesn't match any material
+        const FPolygonGroupID PolygonGroupID = OutMeshDescription.CreatePolygonGroup();
+        PolygonGroupImportedMaterialSlotNames[PolygonGroupID] = FName(*FString::Printf(TEXT("Section_%d"), InOutglTFMaterialIds.Num()));
+        InOutglTFMaterialIds.Add(Primitive->material ? static_cast<int32>(*Primitive->material) : INDEX_NONE);
+
+        VertexIDs.SetNumUninitialized(PointsNum, false);
+        for (int32 i = 0; i < PointsNum; ++i)
+        {
+            const FVertexID VertexID = OutMeshDescription.CreateVertex();
+            VertexPositions[VertexID] = bNodeAbsoluteTransformIsIdentity ? (*Points)[i] : NodeAbsoluteMatrix.TransformPosition((*Points)[i]);
+            VertexIDs[i] = VertexID;
+        }
+
+        /// the missing normals and tangents are left zero, the builder computes them
+        const int32 InstanceNum = bTexCoordsPerWedge ? WedgeIndicesCount : PointsNum;
+        VertexInstanceIDs.SetNumUninitialized(InstanceNum, false);
+        for (int32 i = 0; i < InstanceNum; ++i)
+        {
+            const int32 PointIndex = bTexCoordsPerWedge ? static_cast<int32>(TriangleIndices[i]) : i;
+            const FVertexInstanceID VertexInstanceID = OutMeshDescription.CreateVertexInstance(VertexIDs[PointIndex]);
+            VertexInstanceIDs[i] = VertexInstanceID;
+            if (bHasNormals)
+            {
+                const FVector& Normal = (*Normals)[PointIndex];
+                VertexInstanceNormals[VertexInstanceID] = (bNodeAbsoluteTransformIsIdentity ? Normal : NodeAbsoluteRotation.RotateVector(Normal)) * NormalSign;
+            }
+            if (bHasTangents)
+            {
+                const FVector4& Tangent = (*Tangents)[PointIndex];
+                const FVector TangentX(Tangent.X, Tangent.Y, Tangent.Z);
+                VertexInstanceTangents[VertexInstanceID] = bNodeAbsoluteTransformIsIdentity ? TangentX : NodeAbsoluteRotation.RotateVector(TangentX);
+                VertexInstanceBinormalSigns[VertexInstanceID] = Tangent.W < 0.0f ? -1.0f : 1.0f;
+            }
+            for (int32 j = 0; j < TexCoordCount; ++j)
+            {
+                const TArray<FVector2D>& TextureCoord = FglTFMeshData::Get(MeshData.VertexTexcoords[j]);
+                if (TextureCoord.Num() == InstanceNum)
+                {
+                    VertexInstanceUVs.Set(VertexInstanceID, j, TextureCoord[i]);
+                }
+                else if (TextureCoord.Num() == PointsNum)
                 {
-                    OutRawMesh.WedgeTexCoords[i][j] = WedgeTexCoords[OutRawMesh.WedgeIndices[j] % WedgeTexCoords.Num()];
+                    VertexInstanceUVs.Set(VertexInstanceID, j, TextureCoord[PointIndex]);
                 }
             }
-            else
+        }
+
+        for (int32 i = 0; i < WedgeIndicesCount; i += GLTF_TRIANGLE_POINTS_NUM)
+        {
+            for (int32 j = 0; j < GLTF_TRIANGLE_POINTS_NUM; ++j)
             {
-                OutRawMesh.WedgeTexCoords[i].SetNumZeroed(WedgeIndicesCount);
+                TriangleVertexInstanceIDs[j] = VertexInstanceIDs[bTexCoordsPerWedge ? (i + j) : static_cast<int32>(TriangleIndices[i + j])];
             }
+            /// the polygon can't have the same vertex twice
+            const FVertexID VertexID0 = OutMeshDescription.GetVertexInstanceVertex(TriangleVertexInstanceIDs[0]);
+            const FVertexID VertexID1 = OutMeshDescription.GetVertexInstanceVertex(TriangleVertexInstanceIDs[1]);
+            const FVertexID VertexID2 = OutMeshDescription.GetVertexInstanceVertex(TriangleVertexInstanceIDs[2]);
+            if (VertexID0 == VertexID1 || VertexID1 == VertexID2 || VertexID2 == VertexID0) continue;
+            OutMeshDescription.CreatePolygon(PolygonGroupID, TriangleVertexInstanceIDs);
         }
     }
-    return OutRawMesh.IsValidOrFixable();
+    return OutMeshDescription.Polygons().Num() > 0;
 }
+#endif
 
 #undef LOCTEXT_NAMESPACE
@@ -22,7 +22,14 @@ public:
     class UStaticMesh* CreateStaticMesh(const TWeakPtr<struct FglTFImporterOptions>& InglTFImporterOptions, const std::shared_ptr<libgltf::SGlTF>& InGlTF, const std::shared_ptr<libgltf::SGlTFId>& InMeshId, const class FglTFBuffers& InBuffers
         , const FTransform& InNodeAbsoluteTransform, struct FglTFImporterCollection& InOutglTFImporterCollection) const;
 
+    /// merge the static meshes of the nodes in the subtrees, the node transforms are baked in
+    bool CreateMergedStaticMeshes(const TWeakPtr<struct FglTFImporterOptions>& InglTFImporterOptions, const std::shared_ptr<libgltf::SGlTF>& InGlTF, const TArray<int32>& InRootNodeIds, const class FglTFBuffers& InBuffers
+        , TArray<class UStaticMesh*>& OutStaticMeshes, struct FglTFImporterCollection& InOutglTFImporterCollection) const;
+
 private:
+    class UStaticMesh* BuildStaticMesh(const TWeakPtr<struct FglTFImporterOptions>& InglTFImporterOptions, const std::shared_ptr<libgltf::SGlTF>& InGlTF, const class FglTFBuffers& InBuffers, const FString& InStaticMeshName
+        , struct FRawMesh* InOutRawMesh, struct FMeshDescription* InOutMeshDescription, const TArray<int32>& InglTFMaterialIds
+        , const glTFForUE4::FFeedbackTaskWrapper& InFeedbackTaskWrapper, struct FglTFImporterCollection& InOutglTFImporterCollection) const;
     bool GenerateRawMesh(const TSharedPtr<struct FglTFImporterOptions> InglTFImporterOptions,
         const std::shared_ptr<libgltf::SGlTF>& InGlTF,
         const std::shared_ptr<libgltf::SMesh>& InMesh,
@@ -40,4 +47,14 @@ private:
         struct FRawMesh& OutRawMesh, int32 InMaterialIndex,
         const glTFForUE4::FFeedbackTaskWrapper& InFeedbackTaskWrapper,
         FglTFImporterCollection& InOutglTFImporterCollection) const;
+#if ENGINE_MINOR_VERSION <= 23
+#else
+    /// one polygon group per primitive, the vertex instances are shared by the triangles
+    bool GenerateMeshDescription(const TSharedPtr<struct FglTFImporterOptions> InglTFImporterOptions,
+        const std::shared_ptr<libgltf::SGlTF>& InGlTF,
+        const std::shared_ptr<libgltf::SMesh>& InMesh,
+        const class FglTFBuffers& InBuffers,
+        const FTransform& InNodeAbsoluteTransform,
+        struct FMeshDescription& OutMeshDescription, TArray<int32>& InOutglTFMaterialIds) const;
+#endif
 };
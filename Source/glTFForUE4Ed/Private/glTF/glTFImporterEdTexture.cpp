@@ -40,9 +40,10 @@ UTexture* FglTFImporterEdTexture::CreateTexture(const TWeakPtr<FglTFImporterOpti
 {
     if (!InglTF || !InTextureId) return nullptr;
     const int32 glTFTextureId = *InTextureId;
-    if (InOutglTFImporterCollection.Textures.Contains(glTFTextureId))
+    UTexture* ImportedTexture = nullptr;
+    if (InOutglTFImporterCollection.FindTexture(glTFTextureId, ImportedTexture))
     {
-        return InOutglTFImporterCollection.Textures[glTFTextureId];
+        return ImportedTexture;
     }
     if (glTFTextureId < 0 || glTFTextureId >= static_cast<int32>(InglTF->textures.size())) return nullptr;
     const std::shared_ptr<libgltf::STexture>& glTFTexture = InglTF->textures[glTFTextureId];
@@ -199,7 +200,7 @@ UTexture* FglTFImporterEdTexture::CreateTexture(const TWeakPtr<FglTFImporterOpti
         FglTFImporterEd::UpdateAssetImportData(NewTexture, ImageFilePath);
     }
 
-    InOutglTFImporterCollection.Textures.Add(glTFTextureId, NewTexture);
+    InOutglTFImporterCollection.AddTexture(glTFTextureId, NewTexture);
     return NewTexture;
 }
 
@@ -37,6 +37,8 @@ public class glTFForUE4Ed : ModuleRules
 #if UE_4_24_OR_LATER
                 "MeshBuilder",
                 "SkeletalMeshUtilitiesCommon",
+                "MeshDescription",
+                "StaticMeshDescription",
 #endif
                 "AnimationModifiers",
                 "glTFForUE4",